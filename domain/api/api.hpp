@@ -118,6 +118,15 @@ private:
     std::lock_guard<std::mutex> lock(requests_mutex_);
     auto it = pending_requests_.find(request_id);
 
+    if (it != pending_requests_.end() && response.contains("data") &&
+        response["data"].is_object() &&
+        response["data"].value("progress", false)) {
+      it->second.timestamp = std::chrono::steady_clock::now();
+      spdlog::debug("Progress for request {}: {}", request_id,
+                    response["data"].dump());
+      return;
+    }
+
     if (it != pending_requests_.end()) {
       it->second.promise.set_value(response);
       pending_requests_.erase(it);
@@ -276,7 +285,7 @@ private:
             .and_then([this](validate::Container params) {
               auto [user_id, container_id] = params;
 
-              nlohmann::json request_msg = {{"type", "get_container_files"},
+              nlohmann::json request_msg = {{"type", "get_container_metrics"},
                                             {"user_id", user_id},
                                             {"container_id", container_id}};
 
@@ -303,14 +312,23 @@ private:
                 spdlog::error("VectorFS error: {}",
                               zmq_result.value("error", "Unknown error"));
                 return core::Result<nlohmann::json, std::string>::Error(
-                    zmq_result.value("error", "Failed to get container files"));
+                    zmq_result.value("error", "Failed to get container metrics"));
               }
             })
-            .map([](nlohmann::json data) -> Json::Value {
+            .map([this](nlohmann::json data) -> Json::Value {
               return utils::create_success_response(
-                  {"memory_limit", "cpu_limit"},
-                  data.value("memory_limit", 100),
-                  data.value("cpu_limit", 100));
+                  {"container_id", "sampled_at_ms", "interval_ms",
+                   "memory_limit", "cpu_limit", "memory", "cpu", "io",
+                   "pids"},
+                  convertToJsonValue(data["container_id"]),
+                  convertToJsonValue(data["sampled_at_ms"]),
+                  convertToJsonValue(data["interval_ms"]),
+                  convertToJsonValue(data["memory_limit"]),
+                  convertToJsonValue(data["cpu_limit"]),
+                  convertToJsonValue(data["memory"]),
+                  convertToJsonValue(data["cpu"]),
+                  convertToJsonValue(data["io"]),
+                  convertToJsonValue(data["pids"]));
             });
 
     response.headers().add<Pistache::Http::Header::ContentType>(
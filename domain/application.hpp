@@ -3,6 +3,9 @@
 
 #define FUSE_USE_VERSION 31
 
+#include <atomic>
+#include <chrono>
+
 #include "vfs/core/handlers.hpp"
 #include "vfs/fs/observer.hpp"
 #include "vfs/mq/observer.hpp"
@@ -14,7 +17,8 @@ class Application {
 public:
   Application()
       : state_{}, fs_observer_{state_}, mq_observer_{state_},
-        event_handlers_{state_}, fs_processor_{kBaseContainerPath} {}
+        event_handlers_{state_}, fs_processor_{kBaseContainerPath},
+        boot_workers_{kBootConcurrency} {}
 
   int run(int argc, char *argv[]);
 
@@ -23,12 +27,18 @@ public:
   void stop();
 
 private:
+  void bringUpContainer(ossec::Container container_data);
+
   State state_;
   FileSystemObserver fs_observer_;
   MQObserver<> mq_observer_;
   Operators event_handlers_;
 
   FSProcessor fs_processor_;
+  std::chrono::steady_clock::time_point boot_started_;
+  std::atomic<std::size_t> booting_{0};
+  // Last, so that running bring-ups finish before anything they touch goes.
+  WorkerPool boot_workers_;
 };
 
 } // namespace owl
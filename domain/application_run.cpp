@@ -3,8 +3,6 @@
 namespace owl {
 
 int Application::run(int argc, char *argv[]) {
-  mq_observer_.start();
-
   auto containers = fs_processor_.parseBaseDir();
 
   if (containers.empty()) {
@@ -13,6 +11,7 @@ int Application::run(int argc, char *argv[]) {
 
   setupBaseFileSystem();
   setupFileSystem(containers);
+  mq_observer_.start();
 
   return fs_observer_.run(argc, argv);
 }
@@ -21,43 +20,67 @@ void Application::setupBaseFileSystem() {
   fs_observer_.mkdir("/.containers/")
 }
 
+// Returns at once: containers are brought up kBootConcurrency at a time
+// while the mount is already being served. Until a container is done,
+// state_.loader_ reports it as loading.
 void Application::setupFileSystem(const Containers &containers) {
-  for (auto &container_data : containers) {
-    spdlog::info("Setting up container: {}", container_data.container_id);
-
-    try {
-      auto pid_container =
-          std::make_shared<ossec::PidContainer>(std::move(container_data));
-
-      auto result = state_.container_manager_.createAndRegisterContainer(
-          std::move(pid_container), kModelPath);
-
-      if (!result.is_ok()) {
-        spdlog::error("Failed to register container: {}",
-                      result.error().what());
-      } else {
-        spdlog::info("Successfully registered container: {}",
-                     container_data.container_id);
-
-        auto container_result =
-            state_.container_manager_.getContainer(container_data.container_id);
-
-        if (container_result.is_ok()) {
-          auto start_result = container_result.value()->ensureRunning();
-          if (!start_result.is_ok()) {
-            spdlog::warn("Container {} not started: {}",
-                         container_data.container_id,
-                         start_result.error().what());
-          }
-
-          fs_observer_.mkdir(container_result.value()->);
+  boot_started_ = std::chrono::steady_clock::now();
+  booting_.store(containers.size(), std::memory_order_release);
+
+  for (const auto &container_data : containers) {
+    state_.loader_.begin(container_data.container_id);
+  }
+  for (auto container_data : containers) {
+    boot_workers_.post(
+        [this, container_data = std::move(container_data)]() mutable {
+          bringUpContainer(std::move(container_data));
+        });
+  }
+}
+
+void Application::bringUpContainer(ossec::Container container_data) {
+  const auto started = std::chrono::steady_clock::now();
+  const auto id = container_data.container_id;
+  spdlog::info("Setting up container: {}", id);
+
+  try {
+    auto pid_container =
+        std::make_shared<ossec::PidContainer>(std::move(container_data));
+
+    auto result = state_.container_manager_.createAndRegisterContainer(
+        std::move(pid_container), kModelPath, SearchWarmup::Lazy,
+        &state_.residency_);
+
+    if (!result.is_ok()) {
+      spdlog::error("Failed to register container: {}", result.error().what());
+    } else {
+      spdlog::info("Successfully registered container: {}", id);
+
+      auto container_result = state_.container_manager_.getContainer(id);
+
+      if (container_result.is_ok()) {
+        auto start_result = container_result.value()->bringUp();
+        if (!start_result.is_ok()) {
+          spdlog::warn("Container {} not started: {}", id,
+                       start_result.error().what());
         }
       }
-
-    } catch (const std::exception &e) {
-      spdlog::error("Error setting up container {}: {}",
-                    container_data.container_id, e.what());
     }
+  } catch (const std::exception &e) {
+    spdlog::error("Error setting up container {}: {}", id, e.what());
+  }
+
+  state_.loader_.finish(id);
+  spdlog::info("Container {} loaded in {} ms", id,
+               std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now() - started)
+                   .count());
+
+  if (booting_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    spdlog::info("All containers loaded in {} ms",
+                 std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::steady_clock::now() - boot_started_)
+                     .count());
   }
 }
 
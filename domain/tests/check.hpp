@@ -0,0 +1,17 @@
+#ifndef OWL_TESTS_CHECK
+#define OWL_TESTS_CHECK
+
+#include <cstdio>
+#include <cstdlib>
+
+// Unlike assert(), stays on in release builds.
+#define OWL_CHECK(...)                                                         \
+  do {                                                                         \
+    if (!(__VA_ARGS__)) {                                                      \
+      std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__,    \
+                   #__VA_ARGS__);                                              \
+      std::exit(1);                                                            \
+    }                                                                          \
+  } while (0)
+
+#endif // OWL_TESTS_CHECK
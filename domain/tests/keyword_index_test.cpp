@@ -0,0 +1,62 @@
+#include "tests/check.hpp"
+#include "vfs/core/index/keyword_index.hpp"
+
+#include <string>
+
+using namespace owl;
+
+namespace {
+
+// Rewriting one file must compact the documents it leaves behind, not only
+// explicit removals.
+void rewritesStayBounded() {
+  KeywordIndex index;
+  index.add("/notes.txt", "alpha beta gamma");
+  const auto baseline = index.postingBytes();
+
+  for (int i = 0; i < 10'000; ++i) {
+    index.add("/notes.txt",
+              "alpha beta gamma revision" + std::to_string(i % 7));
+  }
+
+  OWL_CHECK(index.size() == 1);
+  OWL_CHECK(index.postingBytes() < baseline * 8);
+
+  const auto hits = index.search("revision3", 10);
+  OWL_CHECK(hits.size() == 1 && hits[0].first == "/notes.txt");
+  OWL_CHECK(index.search("revision4", 10).empty());
+}
+
+// A document fed a piece at a time scores like the same text added whole.
+void streamedTermsMatchWhole() {
+  KeywordIndex whole;
+  KeywordIndex streamed;
+  const std::string first = "parsing the config loader\n\n";
+  const std::string second = "loader retries the config parse";
+
+  whole.add("/a.txt", first + second);
+  whole.add("/b.txt", "unrelated notes about retries");
+  KeywordIndex::Terms terms;
+  terms.add(first);
+  terms.add(second);
+  streamed.add("/a.txt", terms);
+  streamed.add("/b.txt", "unrelated notes about retries");
+
+  for (const auto *query : {"config loader", "retries", "parse"}) {
+    const auto expected = whole.search(query, 10);
+    const auto actual = streamed.search(query, 10);
+    OWL_CHECK(expected.size() == actual.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      OWL_CHECK(expected[i].first == actual[i].first);
+      OWL_CHECK(expected[i].second == actual[i].second);
+    }
+  }
+}
+
+} // namespace
+
+int main() {
+  rewritesStayBounded();
+  streamedTermsMatchWhole();
+  return 0;
+}
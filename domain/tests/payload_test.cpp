@@ -0,0 +1,95 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+constexpr std::size_t kLarge = std::size_t{1} << 20;
+std::atomic<int> large_allocations{0};
+
+} // namespace
+
+void *operator new(std::size_t n) {
+  if (n >= kLarge) {
+    ++large_allocations;
+  }
+  if (void *p = std::malloc(n)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+#include <boost/hana.hpp>
+namespace hana = boost::hana; // validator.hpp expects its includer to alias it
+
+#include "tests/check.hpp"
+#include "vfs/core/schemas/events.hpp"
+#include "vfs/mq/core/routing.hpp"
+#include "vfs/mq/validator.hpp"
+
+#include <string>
+#include <utility>
+
+using namespace owl;
+
+namespace {
+
+struct TestValidator : Validator<TestValidator> {};
+
+constexpr std::size_t kContentBytes = std::size_t{4} << 20;
+
+std::string createMessage() {
+  return R"({"type":"file_create","request_id":"r","path":"/a",)"
+         R"("user_id":"u","container_id":"c","content":")" +
+         std::string(kContentBytes, 'x') + "\"}";
+}
+
+// File content parsed off the wire reaches the event, and every copy of the
+// event made on the way to the handler, without another large allocation.
+void contentIsNotCopied() {
+  const auto text = createMessage();
+  auto message = nlohmann::json::parse(text);
+  const char *raw = message["content"].get_ref<std::string &>().data();
+
+  const int before = large_allocations;
+  Request request{Verb::Post, "file/create", std::move(message)};
+  auto validated = TestValidator::validate<FileCreateEvent>(request.payload);
+  OWL_CHECK(validated.is_ok());
+
+  auto event = std::move(validated.value());
+  OWL_CHECK(event.content->data() == raw);
+  OWL_CHECK(event.content.size() == kContentBytes);
+
+  auto captured = event;
+  OWL_CHECK(captured.content->data() == raw);
+  OWL_CHECK(captured.content.use_count() == 2);
+
+  FileCreateEvent moved = std::move(captured);
+  OWL_CHECK(moved.content.use_count() == 2);
+  OWL_CHECK(large_allocations == before);
+}
+
+// A const message cannot be moved from, so it is copied once, and a
+// content field of the wrong type is still rejected.
+void constMessagesStillValidate() {
+  const auto message = nlohmann::json::parse(createMessage());
+  auto validated = TestValidator::validate<FileCreateEvent>(message);
+  OWL_CHECK(validated.is_ok());
+  OWL_CHECK(validated.value().content.size() == kContentBytes);
+
+  nlohmann::json wrong{{"path", "/a"},
+                       {"user_id", "u"},
+                       {"container_id", "c"},
+                       {"content", 1}};
+  OWL_CHECK(!TestValidator::validate<FileCreateEvent>(wrong).is_ok());
+}
+
+} // namespace
+
+int main() {
+  contentIsNotCopied();
+  constMessagesStillValidate();
+  return 0;
+}
@@ -0,0 +1,86 @@
+#include "tests/check.hpp"
+#include "vfs/core/index/hub_rank.hpp"
+#include "vfs/core/index/knn_graph.hpp"
+#include "vfs/core/index/rerank.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace owl;
+
+namespace {
+
+constexpr std::size_t kDim = 8;
+
+std::vector<float> near(std::size_t axis, int i) {
+  std::vector<float> v(kDim, 0.01f * static_cast<float>(i % 5));
+  v[axis] = 1.0f;
+  v[(axis + 2 + i % 3) % kDim] += 0.05f;
+  return v;
+}
+
+bool inCluster(const std::string &path, char cluster) {
+  return path.size() > 1 && path[1] == cluster;
+}
+
+// Rewriting a file must move it in the relationship graph straight away:
+// recommendations and the hub ranking come from relations(), not from
+// chunkees' relationship pass, which only bulk paths run.
+void rewriteMovesNeighbors() {
+  KnnGraph graph;
+  for (int i = 0; i < 20; ++i) {
+    const auto a = near(0, i);
+    const auto b = near(1, i);
+    graph.insert("/a" + std::to_string(i), a.data(), kDim);
+    graph.insert("/b" + std::to_string(i), b.data(), kDim);
+  }
+
+  auto x = near(0, 7);
+  graph.insert("/x", x.data(), kDim);
+  const auto before = graph.neighbors("/x", 5);
+  OWL_CHECK(!before.empty());
+  OWL_CHECK(std::all_of(before.begin(), before.end(), [](const auto &n) {
+    return inCluster(n.first, 'a');
+  }));
+
+  HubRank hubs;
+  const auto stale = hubs.ranking(graph);
+
+  x = near(1, 7);
+  graph.insert("/x", x.data(), kDim);
+  const auto after = graph.neighbors("/x", 5);
+  OWL_CHECK(!after.empty());
+  OWL_CHECK(std::all_of(after.begin(), after.end(), [](const auto &n) {
+    return inCluster(n.first, 'b');
+  }));
+
+  const auto fresh = hubs.ranking(graph);
+  OWL_CHECK(fresh->version == graph.version());
+  OWL_CHECK(fresh->version != stale->version);
+  OWL_CHECK(fresh->scores.count("/x") == 1);
+}
+
+// Equal vector scores are broken by hub score; files the ranking has not
+// reached get no boost.
+void hubsBreakTies() {
+  HubRanking ranking;
+  ranking.scores = {{"/p", 0.1f}, {"/q", 0.9f}};
+
+  const auto out =
+      rerankByHubs({{"/p", 0.8f}, {"/q", 0.8f}, {"/r", 0.8f}}, ranking, 3);
+  OWL_CHECK(out.size() == 3);
+  OWL_CHECK(out[0].first == "/q");
+  OWL_CHECK(out[2].first == "/r");
+
+  const auto top = rerankByHubs({{"/p", 0.9f}, {"/q", 0.1f}}, ranking, 1);
+  OWL_CHECK(top.size() == 1 && top[0].first == "/p");
+}
+
+} // namespace
+
+int main() {
+  rewriteMovesNeighbors();
+  hubsBreakTies();
+  return 0;
+}
@@ -0,0 +1,54 @@
+#include "vfs/core/index/simd/kernels.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace owl::simd;
+
+// Scores a 300-d query against a candidate matrix, as the exact rescoring of
+// quantised candidates does, with every kernel variant this CPU can run.
+int main() {
+  constexpr std::size_t kDim = 300;
+  constexpr std::size_t kRows = 20'000;
+  constexpr int kRounds = 50;
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+  std::vector<float> matrix(kDim * kRows);
+  std::vector<float> query(kDim);
+  for (auto &x : matrix) {
+    x = uniform(rng);
+  }
+  for (auto &x : query) {
+    x = uniform(rng);
+  }
+
+  std::printf("dispatch: %s\n", levelName(kernels().level).data());
+
+  std::vector<float> out(kRows);
+  double baseline = 0;
+  for (auto level : {Level::Scalar, Level::Avx2, Level::Avx512}) {
+    if (level > detectLevel()) {
+      continue;
+    }
+    const auto k = detail::selectKernels(level);
+    k.dotRows(query.data(), matrix.data(), kRows, kDim, out.data());
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < kRounds; ++round) {
+      k.dotRows(query.data(), matrix.data(), kRows, kDim, out.data());
+    }
+    const double ms = std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - start)
+                          .count() /
+                      kRounds;
+    if (level == Level::Scalar) {
+      baseline = ms;
+    }
+    std::printf("%-7s %8.3f ms / %zu rows x %zu  (%.2fx)\n",
+                levelName(level).data(), ms, kRows, kDim, baseline / ms);
+  }
+  return 0;
+}
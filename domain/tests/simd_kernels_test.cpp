@@ -0,0 +1,65 @@
+#include "tests/check.hpp"
+#include "vfs/core/index/simd/kernels.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace owl::simd;
+
+namespace {
+
+// Every variant this CPU can run must agree with the scalar kernels,
+// including the tails left over after the last full vector.
+void variantsMatchScalar() {
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+  const auto scalar = detail::selectKernels(Level::Scalar);
+
+  for (std::size_t n : {0, 1, 7, 8, 15, 16, 17, 31, 33, 300, 301}) {
+    std::vector<float> a(n);
+    std::vector<float> b(n);
+    for (auto &x : a) {
+      x = uniform(rng);
+    }
+    for (auto &x : b) {
+      x = uniform(rng);
+    }
+    const float dot = scalar.dot(a.data(), b.data(), n);
+    std::vector<float> fused(n);
+    scalar.fuse(a.data(), 0.3f, b.data(), 0.7f, fused.data(), n);
+
+    for (auto level : {Level::Avx2, Level::Avx512}) {
+      if (level > detectLevel()) {
+        continue;
+      }
+      const auto k = detail::selectKernels(level);
+      OWL_CHECK(std::fabs(k.dot(a.data(), b.data(), n) - dot) < 1e-4f);
+
+      std::vector<float> out(n);
+      k.fuse(a.data(), 0.3f, b.data(), 0.7f, out.data(), n);
+      for (std::size_t i = 0; i < n; ++i) {
+        OWL_CHECK(std::fabs(out[i] - fused[i]) < 1e-5f);
+      }
+
+      std::vector<float> rows(n * 3);
+      for (auto &x : rows) {
+        x = uniform(rng);
+      }
+      float expected[3];
+      float actual[3];
+      scalar.dotRows(a.data(), rows.data(), 3, n, expected);
+      k.dotRows(a.data(), rows.data(), 3, n, actual);
+      for (int r = 0; r < 3; ++r) {
+        OWL_CHECK(std::fabs(actual[r] - expected[r]) < 1e-4f);
+      }
+    }
+  }
+}
+
+} // namespace
+
+int main() {
+  variantsMatchScalar();
+  return 0;
+}
@@ -0,0 +1,130 @@
+#include "tests/check.hpp"
+#include "vfs/core/index/versioned_vector_index.hpp"
+
+#include <random>
+
+using namespace owl;
+
+namespace {
+
+std::vector<float> randomVector(std::mt19937 &rng, std::size_t dimension) {
+  std::normal_distribution<float> normal;
+  std::vector<float> v(dimension);
+  for (auto &x : v) {
+    x = normal(rng);
+  }
+  return v;
+}
+
+// Rewriting the same files over and over on an HNSW base must not let dead
+// vectors pile up: merges rebuild the graph once too many are dead.
+void hnswUpsertsStayBounded() {
+  constexpr std::size_t kDimension = 16;
+  constexpr std::size_t kFiles = 2000;
+
+  std::mt19937 rng(7);
+  VersionedVectorIndex index;
+  IndexConfig config;
+  config.type = "HNSW32";
+  index.configure(config);
+
+  for (std::size_t i = 0; i < kFiles; ++i) {
+    OWL_CHECK(index.upsert("/f" + std::to_string(i),
+                           randomVector(rng, kDimension))
+                  .is_ok());
+  }
+  index.awaitRebuild();
+  OWL_CHECK(index.snapshot()->factory() == "HNSW32");
+
+  std::vector<float> last;
+  for (int round = 0; round < 20; ++round) {
+    for (std::size_t i = 0; i < kFiles; ++i) {
+      last = randomVector(rng, kDimension);
+      OWL_CHECK(index.upsert("/f" + std::to_string(i), last).is_ok());
+    }
+
+    index.awaitRebuild();
+    const auto snapshot = index.snapshot();
+    OWL_CHECK(snapshot->size() == kFiles);
+    OWL_CHECK(snapshot->tombstones() <=
+              VersionedVectorIndex::kMaxTombstoneRatio * kFiles +
+                  VersionedVectorIndex::kMergeThreshold);
+  }
+
+  const auto hits = index.snapshot()->search(last, 1);
+  OWL_CHECK(hits.size() == 1 && hits[0].first == "/f" + std::to_string(kFiles - 1));
+}
+
+// Removals alone must trigger merges, and stay correct across them.
+void removalsFoldIntoBase() {
+  constexpr std::size_t kDimension = 16;
+  constexpr std::size_t kFiles = 3000;
+  constexpr std::size_t kKept = 50;
+
+  std::mt19937 rng(11);
+  VersionedVectorIndex index;
+  std::vector<std::vector<float>> vectors;
+  for (std::size_t i = 0; i < kFiles; ++i) {
+    vectors.push_back(randomVector(rng, kDimension));
+    OWL_CHECK(index.upsert("/f" + std::to_string(i), vectors.back()).is_ok());
+  }
+
+  const auto before = index.generation();
+  for (std::size_t i = kKept; i < kFiles; ++i) {
+    OWL_CHECK(index.remove("/f" + std::to_string(i)));
+  }
+  // One publish per removal, plus the merges they triggered.
+  OWL_CHECK(index.generation() - before > kFiles - kKept);
+
+  const auto snapshot = index.snapshot();
+  OWL_CHECK(snapshot->size() == kKept);
+  OWL_CHECK(!snapshot->contains("/f" + std::to_string(kFiles - 1)));
+  const auto hits = snapshot->search(vectors[kKept - 1], 1);
+  OWL_CHECK(hits.size() == 1 &&
+            hits[0].first == "/f" + std::to_string(kKept - 1));
+}
+
+// A migration trains in the background from the snapshot it started with;
+// upserts and removals made meanwhile must survive the swap.
+void writesDuringRebuildSurvive() {
+  constexpr std::size_t kDimension = 16;
+  constexpr std::size_t kFiles = VersionedVectorIndex::kMergeThreshold;
+
+  std::mt19937 rng(3);
+  VersionedVectorIndex index;
+  IndexConfig config;
+  config.type = "HNSW32";
+  index.configure(config);
+
+  for (std::size_t i = 0; i < kFiles; ++i) {
+    OWL_CHECK(index.upsert("/f" + std::to_string(i),
+                           randomVector(rng, kDimension))
+                  .is_ok());
+  }
+
+  const auto moved = randomVector(rng, kDimension);
+  OWL_CHECK(index.upsert("/f0", moved).is_ok());
+  OWL_CHECK(index.remove("/f1"));
+  const auto added = randomVector(rng, kDimension);
+  OWL_CHECK(index.upsert("/new", added).is_ok());
+
+  index.awaitRebuild();
+  const auto snapshot = index.snapshot();
+  OWL_CHECK(snapshot->factory() == "HNSW32");
+  OWL_CHECK(snapshot->size() == kFiles);
+  OWL_CHECK(!snapshot->contains("/f1"));
+
+  auto hits = snapshot->search(moved, 1);
+  OWL_CHECK(hits.size() == 1 && hits[0].first == "/f0");
+  hits = snapshot->search(added, 1);
+  OWL_CHECK(hits.size() == 1 && hits[0].first == "/new");
+}
+
+} // namespace
+
+int main() {
+  hnswUpsertsStayBounded();
+  removalsFoldIntoBase();
+  writesDuringRebuildSurvive();
+  return 0;
+}
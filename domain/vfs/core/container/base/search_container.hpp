@@ -17,6 +17,16 @@ public:
     return derived().enhancedSemanticSearch(query, limit);
   }
 
+  core::Result<std::vector<std::pair<std::string, float>>>
+  keywordSearch(const std::string &query, int limit = 10) {
+    return derived().keywordSearch(query, limit);
+  }
+
+  core::Result<std::vector<std::pair<std::string, float>>>
+  fusedSearch(const std::string &query, int limit = 10) {
+    return derived().fusedSearch(query, limit);
+  }
+
   core::Result<std::vector<std::string>>
   getRecommendations(const std::string &current_file, int limit = 5) {
     return derived().getRecommendations(current_file, limit);
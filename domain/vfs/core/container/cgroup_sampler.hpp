@@ -0,0 +1,243 @@
+#ifndef OWL_VFS_CORE_CONTAINER_CGROUP_SAMPLER
+#define OWL_VFS_CORE_CONTAINER_CGROUP_SAMPLER
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "vfs/core/loop/periodic_task.hpp"
+
+namespace owl {
+
+// One reading of a container's cgroup v2 controllers. Limits of 0 mean the
+// cgroup sets none ("max").
+struct CgroupMetrics {
+  std::int64_t sampled_at_ms = 0; // system clock
+
+  std::uint64_t memory_current = 0;
+  std::uint64_t memory_limit = 0;
+  std::uint64_t memory_anon = 0;
+  std::uint64_t memory_file = 0;
+  std::uint64_t memory_kernel = 0;
+  std::uint64_t memory_shmem = 0;
+
+  std::uint64_t cpu_usage_usec = 0;
+  std::uint64_t cpu_user_usec = 0;
+  std::uint64_t cpu_system_usec = 0;
+  std::uint64_t cpu_nr_throttled = 0;
+  std::uint64_t cpu_throttled_usec = 0;
+  double cpu_limit = 0;   // in CPUs, from cpu.max
+  double cpu_percent = 0; // of one CPU since the previous sample
+
+  std::uint64_t io_read_bytes = 0;
+  std::uint64_t io_write_bytes = 0;
+  std::uint64_t io_read_ops = 0;
+  std::uint64_t io_write_ops = 0;
+
+  std::uint64_t pids_current = 0;
+};
+
+namespace cgroup {
+
+inline std::optional<std::string> readFile(const std::filesystem::path &path) {
+  std::ifstream in(path);
+  if (!in) {
+    return std::nullopt;
+  }
+  std::ostringstream out;
+  out << in.rdbuf();
+  return out.str();
+}
+
+inline std::uint64_t parseValue(const std::string &text) {
+  try {
+    return text.rfind("max", 0) == 0 ? 0 : std::stoull(text);
+  } catch (const std::exception &) {
+    return 0;
+  }
+}
+
+// "key value" lines, as in memory.stat and cpu.stat.
+inline std::unordered_map<std::string, std::uint64_t>
+parseFlatKeyed(const std::string &text) {
+  std::unordered_map<std::string, std::uint64_t> values;
+  std::istringstream in(text);
+  std::string key;
+  std::uint64_t value;
+  while (in >> key >> value) {
+    values[key] = value;
+  }
+  return values;
+}
+
+// "MAJ:MIN rbytes=.. wbytes=.. rios=.. wios=.." per device, summed.
+inline void parseIoStat(const std::string &text, CgroupMetrics &m) {
+  std::istringstream lines(text);
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::istringstream fields(line);
+    std::string field;
+    fields >> field; // device
+    while (fields >> field) {
+      const auto eq = field.find('=');
+      if (eq == std::string::npos) {
+        continue;
+      }
+      const auto key = field.substr(0, eq);
+      const auto value = parseValue(field.substr(eq + 1));
+      if (key == "rbytes") {
+        m.io_read_bytes += value;
+      } else if (key == "wbytes") {
+        m.io_write_bytes += value;
+      } else if (key == "rios") {
+        m.io_read_ops += value;
+      } else if (key == "wios") {
+        m.io_write_ops += value;
+      }
+    }
+  }
+}
+
+// "$QUOTA $PERIOD"; "max" for no quota.
+inline double parseCpuMax(const std::string &text) {
+  std::istringstream in(text);
+  std::string quota;
+  double period = 0;
+  if (!(in >> quota >> period) || quota == "max" || period <= 0) {
+    return 0;
+  }
+  return static_cast<double>(parseValue(quota)) / period;
+}
+
+// Nullopt if the cgroup is gone or was never created; files a controller
+// does not provide are left at zero.
+inline std::optional<CgroupMetrics> read(const std::filesystem::path &dir) {
+  auto current = readFile(dir / "memory.current");
+  if (!current) {
+    return std::nullopt;
+  }
+
+  CgroupMetrics m;
+  m.sampled_at_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count();
+  m.memory_current = parseValue(*current);
+
+  if (auto max = readFile(dir / "memory.max")) {
+    m.memory_limit = parseValue(*max);
+  }
+  if (auto stat = readFile(dir / "memory.stat")) {
+    auto values = parseFlatKeyed(*stat);
+    m.memory_anon = values["anon"];
+    m.memory_file = values["file"];
+    m.memory_kernel = values["kernel"];
+    m.memory_shmem = values["shmem"];
+  }
+  if (auto stat = readFile(dir / "cpu.stat")) {
+    auto values = parseFlatKeyed(*stat);
+    m.cpu_usage_usec = values["usage_usec"];
+    m.cpu_user_usec = values["user_usec"];
+    m.cpu_system_usec = values["system_usec"];
+    m.cpu_nr_throttled = values["nr_throttled"];
+    m.cpu_throttled_usec = values["throttled_usec"];
+  }
+  if (auto max = readFile(dir / "cpu.max")) {
+    m.cpu_limit = parseCpuMax(*max);
+  }
+  if (auto stat = readFile(dir / "io.stat")) {
+    parseIoStat(*stat, m);
+  }
+  if (auto pids = readFile(dir / "pids.current")) {
+    m.pids_current = parseValue(*pids);
+  }
+  return m;
+}
+
+} // namespace cgroup
+
+// Reads every container's cgroup in one pass per interval on its own thread
+// and publishes the results as an immutable table, so requests for metrics
+// are a pointer load and a hash probe and never touch the filesystem.
+// Containers whose cgroup cannot be read are left out of the table.
+class CgroupSampler {
+public:
+  using Clock = PeriodicTask::Clock;
+  using Table = std::unordered_map<std::string, CgroupMetrics>;
+  using Snapshot = std::shared_ptr<const Table>;
+  // (container id, cgroup directory) for everything to sample this pass.
+  using Targets = std::function<
+      std::vector<std::pair<std::string, std::filesystem::path>>()>;
+
+  CgroupSampler(Clock::duration interval, Targets targets)
+      : targets_(std::move(targets)), table_(std::make_shared<const Table>()),
+        task_(interval, [this] { sample(); }) {}
+
+  CgroupSampler(const CgroupSampler &) = delete;
+  CgroupSampler &operator=(const CgroupSampler &) = delete;
+
+  Snapshot snapshot() const { return table_.load(std::memory_order_acquire); }
+
+  std::optional<CgroupMetrics> find(const std::string &id) const {
+    const auto table = snapshot();
+    auto it = table->find(id);
+    if (it == table->end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  // Completed passes; lets callers wait for fresh data.
+  std::uint64_t passes() const {
+    return passes_.load(std::memory_order_acquire);
+  }
+
+  Clock::duration interval() const { return task_.interval(); }
+
+private:
+  void sample() {
+    const auto previous = snapshot();
+    auto next = std::make_shared<Table>();
+
+    for (auto &[id, dir] : targets_()) {
+      auto metrics = cgroup::read(dir);
+      if (!metrics) {
+        continue;
+      }
+
+      if (auto it = previous->find(id); it != previous->end()) {
+        const auto &last = it->second;
+        const auto wall_ms = metrics->sampled_at_ms - last.sampled_at_ms;
+        if (wall_ms > 0 && metrics->cpu_usage_usec >= last.cpu_usage_usec) {
+          metrics->cpu_percent =
+              static_cast<double>(metrics->cpu_usage_usec -
+                                  last.cpu_usage_usec) /
+              (static_cast<double>(wall_ms) * 10.0);
+        }
+      }
+      next->emplace(std::move(id), *metrics);
+    }
+
+    table_.store(std::move(next), std::memory_order_release);
+    passes_.fetch_add(1, std::memory_order_release);
+  }
+
+  Targets targets_;
+  std::atomic<Snapshot> table_;
+  std::atomic<std::uint64_t> passes_{0};
+  // Last, so its thread stops before the table goes.
+  PeriodicTask task_;
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_CONTAINER_CGROUP_SAMPLER
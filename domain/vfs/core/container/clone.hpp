@@ -0,0 +1,161 @@
+#ifndef OWL_VFS_CORE_CONTAINER_CLONE
+#define OWL_VFS_CORE_CONTAINER_CLONE
+
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+#include <infrastructure/result.hpp>
+
+namespace owl {
+
+namespace fs = std::filesystem;
+
+// Replaces `path` by writing a sibling temporary and renaming it over the
+// target, so a crash never leaves a half-written file behind. `write` fills
+// the temporary's stream; failures on the destination side are reported as
+// fs::filesystem_error, anything `write` throws is passed through.
+template <typename Write>
+void replaceFileAtomically(const fs::path &path, Write &&write) {
+  fs::create_directories(path.parent_path());
+
+  auto tmp = path;
+  tmp += ".owl-tmp-" +
+         std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+  try {
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    write(out);
+    out.close();
+    if (!out) {
+      throw fs::filesystem_error("write failed", path,
+                                 std::make_error_code(std::errc::io_error));
+    }
+  } catch (...) {
+    std::error_code ec;
+    fs::remove(tmp, ec);
+    throw;
+  }
+
+  fs::rename(tmp, path);
+}
+
+inline void writeFileAtomically(const fs::path &path, std::string_view content) {
+  replaceFileAtomically(path, [&](std::ofstream &out) {
+    out.write(content.data(), static_cast<std::streamsize>(content.size()));
+  });
+}
+
+// Copies `source`, anything with read(dst, n) returning 0 at the end, through
+// a fixed buffer. Returns the number of bytes written.
+template <typename Source>
+std::uint64_t streamFileAtomically(const fs::path &path, Source &source) {
+  std::uint64_t total = 0;
+  replaceFileAtomically(path, [&](std::ofstream &out) {
+    std::array<char, 1 << 16> buffer;
+    while (out) {
+      const auto n = source.read(buffer.data(), buffer.size());
+      if (n == 0) {
+        break;
+      }
+      out.write(buffer.data(), static_cast<std::streamsize>(n));
+      total += n;
+    }
+  });
+  return total;
+}
+
+struct CloneStats {
+  std::size_t reflinked = 0;
+  std::size_t copied = 0;
+};
+
+namespace detail {
+
+inline bool reflinkFile(const fs::path &from, const fs::path &to) {
+  const int src = ::open(from.c_str(), O_RDONLY | O_CLOEXEC);
+  if (src < 0) {
+    return false;
+  }
+
+  const int dst =
+      ::open(to.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+  if (dst < 0) {
+    ::close(src);
+    return false;
+  }
+
+  const bool ok = ::ioctl(dst, FICLONE, src) == 0;
+  ::close(src);
+  ::close(dst);
+
+  if (!ok) {
+    std::error_code ec;
+    fs::remove(to, ec);
+  }
+  return ok;
+}
+
+} // namespace detail
+
+// Mirrors `source` into `target` sharing data blocks where the filesystem
+// allows it: reflink first (btrfs, xfs), a real copy otherwise. Files are
+// never hardlinked, since a shared inode would carry one container's in-place
+// writes into the other.
+inline core::Result<CloneStats> cloneTree(const fs::path &source,
+                                          const fs::path &target) {
+  using Error = std::runtime_error;
+
+  CloneStats stats;
+  try {
+    if (fs::exists(target)) {
+      return core::Result<CloneStats, Error>::Error(
+          Error("clone target already exists: " + target.string()));
+    }
+    fs::create_directories(target);
+
+    bool reflink_supported = true;
+    for (const auto &entry : fs::recursive_directory_iterator(source)) {
+      const auto to = target / fs::relative(entry.path(), source);
+
+      if (entry.is_directory()) {
+        fs::create_directories(to);
+        continue;
+      }
+      if (!entry.is_regular_file()) {
+        continue;
+      }
+
+      if (reflink_supported && detail::reflinkFile(entry.path(), to)) {
+        ++stats.reflinked;
+        continue;
+      }
+      reflink_supported = false;
+
+      fs::copy_file(entry.path(), to);
+      ++stats.copied;
+    }
+
+    return core::Result<CloneStats, Error>::Ok(stats);
+  } catch (const std::exception &e) {
+    std::error_code ec;
+    fs::remove_all(target, ec);
+    return core::Result<CloneStats, Error>::Error(
+        Error(std::string("clone failed: ") + e.what()));
+  }
+}
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_CONTAINER_CLONE
@@ -0,0 +1,83 @@
+#ifndef OWL_VFS_CORE_CONTAINER_CONTAINER_LOADER
+#define OWL_VFS_CORE_CONTAINER_CONTAINER_LOADER
+
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+
+#include <infrastructure/result.hpp>
+
+namespace owl {
+
+// What a request for a container that is still being brought up does: wait
+// for it (up to a limit) or be refused straight away.
+enum class LoadingPolicy { Queue, FailFast };
+
+// Containers between begin() and finish(): found on disk at start-up but not
+// yet registered and started. Requests check gate() so that they see
+// "loading" rather than "not found" while the daemon is coming up; nothing
+// here blocks, so callers on the event loop retry rather than wait.
+class ContainerLoader {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Error = std::runtime_error;
+
+  enum class Gate { Ready, Retry, Refuse };
+
+  // How often a queued request looks again.
+  static constexpr auto kRetryInterval = std::chrono::milliseconds(100);
+
+  ContainerLoader(LoadingPolicy policy, Clock::duration wait)
+      : policy_(policy), wait_(wait) {}
+
+  ContainerLoader(const ContainerLoader &) = delete;
+  ContainerLoader &operator=(const ContainerLoader &) = delete;
+
+  void begin(const std::string &id) {
+    std::lock_guard lock(mutex_);
+    loading_.insert(id);
+  }
+
+  // Successful or not.
+  void finish(const std::string &id) {
+    std::lock_guard lock(mutex_);
+    loading_.erase(id);
+  }
+
+  bool isLoading(const std::string &id) const {
+    std::lock_guard lock(mutex_);
+    return loading_.count(id) > 0;
+  }
+
+  std::size_t loading() const {
+    std::lock_guard lock(mutex_);
+    return loading_.size();
+  }
+
+  // Ready once `id` is not loading (which says nothing about whether it
+  // loaded). Otherwise a request first seen at `since` should try again
+  // later under the Queue policy, until the wait runs out, and be refused
+  // under FailFast.
+  Gate gate(const std::string &id, Clock::time_point since) const {
+    std::lock_guard lock(mutex_);
+    if (!loading_.count(id)) {
+      return Gate::Ready;
+    }
+    if (policy_ == LoadingPolicy::Queue && Clock::now() - since < wait_) {
+      return Gate::Retry;
+    }
+    return Gate::Refuse;
+  }
+
+private:
+  const LoadingPolicy policy_;
+  const Clock::duration wait_;
+  mutable std::mutex mutex_;
+  std::unordered_set<std::string> loading_;
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_CONTAINER_CONTAINER_LOADER
@@ -4,14 +4,21 @@
 #include <infrastructure/result.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace owl {
 
+// Readers load an immutable registry snapshot and never take the writers'
+// mutex; registration copies the registry and publishes the copy. Owner and
+// label lookups go through indexes kept alongside the id map, so they cost
+// what they return rather than a scan. Labels are indexed as they are at
+// registration.
 template <typename ContainerT> class ContainerManager {
 public:
   using ContainerPtr = std::shared_ptr<ContainerT>;
@@ -19,32 +26,17 @@ public:
   using ContainerList = std::vector<ContainerPtr>;
   using Error = std::runtime_error;
 
-  ContainerManager() = default;
+  ContainerManager() : registry_(std::make_shared<const Registry>()) {}
 
   ContainerManager(const ContainerManager &) = delete;
   ContainerManager &operator=(const ContainerManager &) = delete;
-  ContainerManager(ContainerManager &&) = default;
-  ContainerManager &operator=(ContainerManager &&) = default;
 
+  // The container is constructed before the registry is locked, so slow
+  // constructors do not hold up other registrations.
   template <typename... Args>
   core::Result<void> createAndRegisterContainer(Args &&...args) {
-    std::lock_guard lock(mutex_);
-
-    auto container = std::make_shared<ContainerT>(std::forward<Args>(args)...);
-
-    if (!validateContainer(container)) {
-      return core::Result<void, Error>::Error(Error("Invalid container"));
-    }
-
-    const auto &id = container->getId();
-
-    if (containers_.find(id) != containers_.end()) {
-      return core::Result<void, Error>::Error(
-          Error("Container already registered: " + id));
-    }
-
-    containers_.emplace(id, std::move(container));
-    return core::Result<void, Error>::Ok();
+    return registerContainer(
+        std::make_shared<ContainerT>(std::forward<Args>(args)...));
   }
 
   core::Result<void> registerContainer(ContainerPtr container) {
@@ -52,15 +44,18 @@ public:
       return core::Result<void, Error>::Error(Error("Invalid container"));
     }
 
-    std::lock_guard lock(mutex_);
-    const auto &id = container->getId();
+    const auto id = container->getId();
+    std::lock_guard lock(writer_);
+    const auto current = snapshot();
 
-    if (containers_.find(id) != containers_.end()) {
+    if (current->by_id.count(id)) {
       return core::Result<void, Error>::Error(
           Error("Container already registered: " + id));
     }
 
-    containers_.emplace(id, std::move(container));
+    auto next = std::make_shared<Registry>(*current);
+    next->add(id, std::move(container));
+    publish(std::move(next));
     return core::Result<void, Error>::Ok();
   }
 
@@ -69,13 +64,17 @@ public:
       return core::Result<void, Error>::Error(Error("Invalid container ID"));
     }
 
-    std::lock_guard lock(mutex_);
+    std::lock_guard lock(writer_);
+    const auto current = snapshot();
 
-    if (!removeContainerUnsafe(id)) {
+    if (!current->by_id.count(id)) {
       return core::Result<void, Error>::Error(
           Error("No such container: " + id));
     }
 
+    auto next = std::make_shared<Registry>(*current);
+    next->remove(id);
+    publish(std::move(next));
     return core::Result<void, Error>::Ok();
   }
 
@@ -85,15 +84,15 @@ public:
           Error("Invalid container ID"));
     }
 
-    std::lock_guard lock(mutex_);
-    auto container = findContainerUnsafe(id);
+    const auto current = snapshot();
+    auto it = current->by_id.find(id);
 
-    if (!container) {
+    if (it == current->by_id.end()) {
       return core::Result<ContainerPtr, Error>::Error(
           Error("No such container: " + id));
     }
 
-    return core::Result<ContainerPtr, Error>::Ok(container);
+    return core::Result<ContainerPtr, Error>::Ok(it->second);
   }
 
   core::Result<void> deleteContainer(const std::string &id) {
@@ -101,64 +100,68 @@ public:
   }
 
   ContainerList getAllContainers() const {
-    std::lock_guard lock(mutex_);
-    return filterContainersUnsafe([](const ContainerPtr &) { return true; });
+    const auto current = snapshot();
+    ContainerList result;
+    result.reserve(current->by_id.size());
+    for (const auto &[id, container] : current->by_id) {
+      result.push_back(container);
+    }
+    return result;
   }
 
   ContainerList getContainersByOwner(const std::string &owner) const {
-    std::lock_guard lock(mutex_);
-    return filterContainersUnsafe([&owner](const ContainerPtr &container) {
-      return container->getOwner() == owner;
-    });
+    const auto current = snapshot();
+    auto it = current->by_owner.find(owner);
+    return it == current->by_owner.end() ? ContainerList{} : it->second;
   }
 
   ContainerList getAvailableContainers() const {
-    std::lock_guard lock(mutex_);
-    return filterContainersUnsafe(
+    return filterContainers(
         [](const ContainerPtr &container) { return container->isAvailable(); });
   }
 
   ContainerList findContainersByLabel(const std::string &key,
                                       const std::string &value = "") const {
-    std::lock_guard lock(mutex_);
-    return filterContainersUnsafe(
-        [&key, &value](const ContainerPtr &container) {
-          auto labels = container->getLabels();
-          auto it = labels.find(key);
+    const auto current = snapshot();
+    auto values = current->by_label.find(key);
+    if (values == current->by_label.end()) {
+      return {};
+    }
 
-          if (it == labels.end()) {
-            return false;
-          }
+    if (!value.empty()) {
+      auto it = values->second.find(value);
+      return it == values->second.end() ? ContainerList{} : it->second;
+    }
 
-          return value.empty() || it->second == value;
-        });
+    ContainerList result;
+    for (const auto &[label_value, containers] : values->second) {
+      result.insert(result.end(), containers.begin(), containers.end());
+    }
+    return result;
   }
 
   std::vector<std::string> getCommands() const {
-    std::lock_guard lock(mutex_);
+    const auto current = snapshot();
     std::vector<std::string> result;
-    for (const auto &[id, container] : containers_) {
+    for (const auto &[id, container] : current->by_id) {
       auto commands = container->getCommands();
       result.insert(result.end(), commands.begin(), commands.end());
     }
     return result;
   }
 
-  std::size_t getContainerCount() const {
-    std::lock_guard lock(mutex_);
-    return containers_.size();
-  }
+  std::size_t getContainerCount() const { return snapshot()->by_id.size(); }
 
   std::size_t getAvailableContainerCount() const {
-    std::lock_guard lock(mutex_);
+    const auto current = snapshot();
     return std::count_if(
-        containers_.begin(), containers_.end(),
+        current->by_id.begin(), current->by_id.end(),
         [](const auto &pair) { return pair.second->isAvailable(); });
   }
 
   void clear() {
-    std::lock_guard lock(mutex_);
-    containers_.clear();
+    std::lock_guard lock(writer_);
+    publish(std::make_shared<const Registry>());
   }
 
   bool contains(const std::string &id) const {
@@ -166,35 +169,80 @@ public:
       return false;
     }
 
-    std::lock_guard lock(mutex_);
-    return containers_.find(id) != containers_.end();
+    return snapshot()->by_id.count(id) > 0;
   }
 
-  bool isEmpty() const {
-    std::lock_guard lock(mutex_);
-    return containers_.empty();
-  }
+  bool isEmpty() const { return snapshot()->by_id.empty(); }
 
 private:
-  bool validateContainer(const ContainerPtr &container) const {
-    return container != nullptr && !container->getId().empty();
-  }
+  using LabelIndex =
+      std::unordered_map<std::string,
+                         std::unordered_map<std::string, ContainerList>>;
+
+  struct Registry {
+    ContainerMap by_id;
+    std::unordered_map<std::string, ContainerList> by_owner;
+    LabelIndex by_label;
+
+    void add(const std::string &id, ContainerPtr container) {
+      by_owner[container->getOwner()].push_back(container);
+      for (const auto &[key, value] : container->getLabels()) {
+        by_label[key][value].push_back(container);
+      }
+      by_id.emplace(id, std::move(container));
+    }
 
-  bool validateContainerId(const std::string &id) const { return !id.empty(); }
+    void remove(const std::string &id) {
+      auto it = by_id.find(id);
+      const auto container = it->second;
+      by_id.erase(it);
+
+      erase(by_owner, container->getOwner(), container);
+      for (const auto &[key, value] : container->getLabels()) {
+        auto values = by_label.find(key);
+        if (values == by_label.end()) {
+          continue;
+        }
+        erase(values->second, value, container);
+        if (values->second.empty()) {
+          by_label.erase(values);
+        }
+      }
+    }
 
-  ContainerPtr findContainerUnsafe(const std::string &id) const {
-    auto it = containers_.find(id);
-    return it != containers_.end() ? it->second : nullptr;
+    static void erase(std::unordered_map<std::string, ContainerList> &index,
+                      const std::string &key, const ContainerPtr &container) {
+      auto it = index.find(key);
+      if (it == index.end()) {
+        return;
+      }
+      auto &list = it->second;
+      list.erase(std::remove(list.begin(), list.end(), container), list.end());
+      if (list.empty()) {
+        index.erase(it);
+      }
+    }
+  };
+
+  using Snapshot = std::shared_ptr<const Registry>;
+
+  Snapshot snapshot() const { return registry_.load(std::memory_order_acquire); }
+
+  void publish(Snapshot next) {
+    registry_.store(std::move(next), std::memory_order_release);
   }
 
-  bool removeContainerUnsafe(const std::string &id) {
-    return containers_.erase(id) > 0;
+  bool validateContainer(const ContainerPtr &container) const {
+    return container != nullptr && !container->getId().empty();
   }
 
+  bool validateContainerId(const std::string &id) const { return !id.empty(); }
+
   template <typename Predicate>
-  ContainerList filterContainersUnsafe(Predicate predicate) const {
+  ContainerList filterContainers(Predicate predicate) const {
+    const auto current = snapshot();
     ContainerList result;
-    for (const auto &[id, container] : containers_) {
+    for (const auto &[id, container] : current->by_id) {
       if (predicate(container)) {
         result.push_back(container);
       }
@@ -202,10 +250,10 @@ private:
     return result;
   }
 
-  mutable std::mutex mutex_;
-  ContainerMap containers_;
+  std::mutex writer_;
+  std::atomic<Snapshot> registry_;
 };
 
 } // namespace owl
 
-#endif // OWL_VFS_CORE_CONTAINER_MANAGER_HPP
\ No newline at end of file
+#endif // OWL_VFS_CORE_CONTAINER_MANAGER_HPP
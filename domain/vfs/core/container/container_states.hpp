@@ -7,6 +7,7 @@
 namespace owl::container {
 
 struct Stopped {};
+struct Loading {};
 struct Running {};
 struct Invalid {};
 struct Unknown {};
@@ -16,6 +17,7 @@ struct Unknown {};
 namespace core {
 
 template <> struct is_state<owl::container::Stopped> : std::true_type {};
+template <> struct is_state<owl::container::Loading> : std::true_type {};
 template <> struct is_state<owl::container::Running> : std::true_type {};
 template <> struct is_state<owl::container::Invalid> : std::true_type {};
 template <> struct is_state<owl::container::Unknown> : std::true_type {};
@@ -24,8 +26,9 @@ template <> struct is_state<owl::container::Unknown> : std::true_type {};
 
 namespace owl {
 
-using StateVariant = std::variant<container::Stopped, container::Running,
-                                  container::Invalid, container::Unknown>;
+using StateVariant =
+    std::variant<container::Stopped, container::Loading, container::Running,
+                 container::Invalid, container::Unknown>;
 
 using ContainerTransitionTable = core::TransitionTable<
     core::Transition<container::Stopped, container::Running>,
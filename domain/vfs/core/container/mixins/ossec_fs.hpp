@@ -10,6 +10,7 @@
 #include <spdlog/spdlog.h>
 
 #include "ossec_fs_helpers.hpp"
+#include "vfs/core/container/clone.hpp"
 
 namespace owl {
 
@@ -40,6 +41,9 @@ public:
 
     try {
       for (const auto &entry : fs::directory_iterator(data_path / real_path)) {
+        if (entry.path().filename() == kOwlStateDir) {
+          continue;
+        }
         if (entry.is_regular_file() || entry.is_directory()) {
           files.push_back(entry.path().filename().string());
         }
@@ -115,14 +119,9 @@ public:
     const auto search_path = this->normalizeVirtualPathAsRooted(virtual_path);
 
     try {
-      fs::create_directories(full_path.parent_path());
+      writeFileAtomically(full_path, content);
 
-      std::ofstream file(full_path);
-      if (!file) {
-        return core::Result<void, Error>::Error(
-            Error("failed to open file for write: " + full_path.string()));
-      }
-      file << content;
+      this->derived().pathIndex().add(this->normalizeVirtualPath(virtual_path));
 
       return this->derived().indexFileInSearch(search_path, content, "write");
     } catch (const std::exception &e) {
@@ -143,6 +142,9 @@ public:
             Error("file not removed: " + full_path.string()));
       }
 
+      this->derived().pathIndex().remove(
+          this->normalizeVirtualPath(virtual_path));
+
       return this->derived().removeFileFromSearch(search_path);
     } catch (const std::exception &e) {
       return core::Result<void, Error>::Error(
@@ -152,23 +154,9 @@ public:
 
   core::Result<std::vector<std::string>>
   searchFiles(const std::string &pattern) const {
-    const auto &data_path =
-        this->derived().getNative()->get_container().data_path;
-    std::vector<std::string> results;
-
     try {
-      for (const auto &entry : fs::recursive_directory_iterator(data_path)) {
-        if (!entry.is_regular_file()) {
-          continue;
-        }
-
-        const std::string filename = entry.path().filename().string();
-        if (filename.find(pattern) != std::string::npos) {
-          results.push_back(fs::relative(entry.path(), data_path).string());
-        }
-      }
       return core::Result<std::vector<std::string>, Error>::Ok(
-          std::move(results));
+          this->derived().pathIndex().find(pattern));
     } catch (const std::exception &e) {
       return core::Result<std::vector<std::string>, Error>::Error(
           Error(std::string("searchFiles error: ") + e.what()));
@@ -197,6 +185,34 @@ public:
     }
   }
 
+  void initializePathIndexFromFs() {
+    const auto &data_path =
+        this->derived().getNative()->get_container().data_path;
+    auto &index = this->derived().pathIndex();
+    index.clear();
+
+    if (!fs::exists(data_path) || !fs::is_directory(data_path)) {
+      return;
+    }
+
+    try {
+      for (auto it = fs::recursive_directory_iterator(data_path);
+           it != fs::recursive_directory_iterator(); ++it) {
+        if (it->is_directory() && it->path().filename() == kOwlStateDir) {
+          it.disable_recursion_pending();
+          continue;
+        }
+        if (it->is_regular_file()) {
+          index.add(fs::relative(it->path(), data_path).string());
+        }
+      }
+      spdlog::info("Path index for {} built: {} files", derived().getId(),
+                   index.size());
+    } catch (const std::exception &e) {
+      spdlog::warn("initializePathIndex: {}", e.what());
+    }
+  }
+
 private:
   const Derived &derived() const { return static_cast<const Derived &>(*this); }
   Derived &derived() { return static_cast<Derived &>(*this); }
@@ -11,6 +11,10 @@ namespace owl {
 
 namespace fs = std::filesystem;
 
+// Owl's own per-container state (vector snapshots etc.) lives under
+// `<data_path>/.owl` and is hidden from listings and the path index.
+inline constexpr const char *kOwlStateDir = ".owl";
+
 template <typename Derived> class OssecFsHelpersMixin {
 protected:
   bool isRootVirtualPath(const std::string &virtual_path) const {
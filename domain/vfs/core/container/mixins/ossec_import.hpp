@@ -0,0 +1,177 @@
+#ifndef OWL_VFS_CORE_CONTAINER_MIXINS_OSSEC_IMPORT
+#define OWL_VFS_CORE_CONTAINER_MIXINS_OSSEC_IMPORT
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <infrastructure/result.hpp>
+#include <spdlog/spdlog.h>
+
+#include "ossec_fs_helpers.hpp"
+#include "vfs/core/container/clone.hpp"
+#include "vfs/core/import/archive_reader.hpp"
+#include "vfs/core/index/embedding.hpp"
+#include "vfs/core/index/passage_chunker.hpp"
+#include "vfs/core/index/search_filter.hpp"
+#include "vfs/core/loop/bounded_queue.hpp"
+#include "vfs/fs/processor/manifest.hpp"
+
+namespace owl {
+
+namespace fs = std::filesystem;
+
+struct ImportStats {
+  std::size_t written = 0;
+  std::size_t indexed = 0;
+  std::size_t failed = 0;
+  std::size_t bytes = 0;
+  std::chrono::milliseconds elapsed{0};
+};
+
+using ImportProgress = std::function<void(const ImportStats &)>;
+
+// Bulk ingest: the reader streams each entry's body straight into its file
+// under data_path, and a single indexer reads the written files back to feed
+// the search index without rebuilding. Bodies are only ever held one buffer
+// at a time and the queue between the stages is bounded, so memory stays
+// flat no matter how large the source or its entries are. The index is
+// refreshed once at the end.
+template <typename Derived> class OssecImportMixin {
+public:
+  using Error = std::runtime_error;
+
+  static constexpr std::size_t kImportQueueDepth = 64;
+  static constexpr std::size_t kImportProgressEvery = 256;
+
+  core::Result<ImportStats> importFrom(const fs::path &source,
+                                       std::uint64_t max_entry_bytes,
+                                       const ImportProgress &progress = {}) {
+    const auto started = std::chrono::steady_clock::now();
+    const auto pin = derived().pinIndex();
+    const auto data_path = derived().getNative()->get_container().data_path;
+
+    BoundedQueue<ImportEntry> to_index(kImportQueueDepth);
+
+    std::atomic<std::size_t> written{0};
+    std::atomic<std::size_t> indexed{0};
+    std::atomic<std::size_t> failed{0};
+    std::atomic<std::size_t> bytes{0};
+
+    const auto snapshot = [&]() {
+      return ImportStats{
+          written.load(), indexed.load(), failed.load(), bytes.load(),
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now() - started)};
+    };
+
+    std::thread indexer([&]() {
+      while (auto entry = to_index.pop()) {
+        const auto search_path = "/" + entry->path;
+        FileSource source((data_path / entry->path).string());
+        if (!source.good()) {
+          spdlog::warn("import: cannot reopen {}", search_path);
+          ++failed;
+          continue;
+        }
+        auto ingested =
+            derived().ingestFile(search_path, source, {.search_text = true});
+
+        FileMeta meta;
+        bool added = true;
+        {
+          std::lock_guard lock(derived().searchMutex());
+          auto r = derived().search().addFile(search_path,
+                                              ingested.search_text);
+          if (!r.is_ok()) {
+            spdlog::warn("import: failed to index {}: {}", search_path,
+                         r.error().what());
+            added = false;
+          }
+          meta = derived().describeFile(search_path);
+        }
+
+        if (ingested.vector) {
+          derived().upsertVector(search_path, std::move(*ingested.vector), meta);
+        }
+        if (!added) {
+          ++failed;
+          continue;
+        }
+
+        derived().bumpSearchGeneration();
+        if (++indexed % kImportProgressEvery == 0 && progress) {
+          progress(snapshot());
+        }
+      }
+    });
+
+    // Errors on the source side end the import; a file that cannot be
+    // written is counted as failed and skipped.
+    std::optional<std::string> read_error;
+    try {
+      forEachImportEntry(
+          source, max_entry_bytes, [&](ImportEntry entry, auto &body) {
+            // Neither owl's state nor the container's own config may be
+            // replaced from an import.
+            if (fs::path(entry.path).begin()->string() == kOwlStateDir ||
+                entry.path == kContainerConfigFile) {
+              spdlog::warn("import: skipping reserved path {}", entry.path);
+              return;
+            }
+
+            try {
+              bytes += streamFileAtomically(data_path / entry.path, body);
+            } catch (const fs::filesystem_error &e) {
+              spdlog::warn("import: {}", e.what());
+              ++failed;
+              return;
+            }
+
+            derived().pathIndex().add(entry.path);
+            ++written;
+            to_index.push(std::move(entry));
+          });
+    } catch (const std::exception &e) {
+      read_error = e.what();
+    }
+
+    to_index.close();
+    indexer.join();
+
+    {
+      std::lock_guard lock(derived().searchMutex());
+      derived().rebuildSearchIndexWithRelationships();
+    }
+    derived().bumpSearchGeneration();
+    derived().persistVectorIndex();
+
+    const auto stats = snapshot();
+    spdlog::info("Imported {} files ({} bytes, {} failed) into {} in {} ms",
+                 stats.indexed, stats.bytes, stats.failed, derived().getId(),
+                 stats.elapsed.count());
+
+    if (read_error) {
+      return core::Result<ImportStats, Error>::Error(
+          Error("import from " + source.string() + " stopped after " +
+                std::to_string(stats.written) + " files: " + *read_error));
+    }
+    return core::Result<ImportStats, Error>::Ok(stats);
+  }
+
+private:
+  const Derived &derived() const { return static_cast<const Derived &>(*this); }
+  Derived &derived() { return static_cast<Derived &>(*this); }
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_CONTAINER_MIXINS_OSSEC_IMPORT
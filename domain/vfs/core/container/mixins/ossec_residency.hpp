@@ -0,0 +1,263 @@
+#ifndef OWL_VFS_CORE_CONTAINER_MIXINS_OSSEC_RESIDENCY
+#define OWL_VFS_CORE_CONTAINER_MIXINS_OSSEC_RESIDENCY
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+
+#include <spdlog/spdlog.h>
+
+#include "vfs/core/container/container_states.hpp"
+#include "vfs/core/container/residency.hpp"
+
+namespace owl {
+
+// Whether the container's search index, with the embedder model and chunkees
+// behind it, is in memory. A stub (Unknown) has only its path index; the
+// first search or file operation activates the
+// index (Loading, then Running), and the ResidencyBudget may later unload it
+// back to the state directory (Stopped) until it is needed again. Start-up
+// work wrapped in whileLoading() reports Loading as well. Residency reuses
+// the container state types but is tracked here, apart from the container's
+// lifecycle state machine.
+//
+// Hibernation goes further than eviction: Derived::hibernateIndex() also
+// saves and drops what loadIndex() does not rebuild and stops the native
+// container, and the next pin undoes it through Derived::wakeIndex() before
+// loading the index.
+template <typename Derived> class OssecResidencyMixin {
+public:
+  using Clock = ResidencyBudget::Clock;
+
+  // Keeps the index resident for the caller's scope, activating it first if
+  // needed. Taken by every public entry point that reads or writes the index.
+  IndexPin pinIndex() {
+    for (;;) {
+      {
+        IndexPin pin(pins_);
+        if (resident_.load(std::memory_order_seq_cst)) {
+          touch();
+          return pin;
+        }
+      }
+      activateIndex();
+    }
+  }
+
+  // A pin only if the index is already resident; never loads or wakes it.
+  std::optional<IndexPin> pinIfResident() {
+    IndexPin pin(pins_);
+    if (!resident_.load(std::memory_order_seq_cst)) {
+      return std::nullopt;
+    }
+    touch();
+    return pin;
+  }
+
+  bool isResident() const { return resident_.load(std::memory_order_acquire); }
+
+  bool isLoading() const {
+    std::lock_guard lock(state_mutex_);
+    return std::holds_alternative<container::Loading>(residency_);
+  }
+
+  std::string getResidency() const {
+    if (isHibernated()) {
+      return "hibernated";
+    }
+    std::lock_guard lock(state_mutex_);
+    if (std::holds_alternative<container::Loading>(residency_)) {
+      return "loading";
+    }
+    if (std::holds_alternative<container::Running>(residency_)) {
+      return "resident";
+    }
+    if (std::holds_alternative<container::Stopped>(residency_)) {
+      return "evicted";
+    }
+    return "stub";
+  }
+
+  bool isHibernated() const {
+    return hibernated_.load(std::memory_order_acquire);
+  }
+
+  // Since the index was last pinned, or since construction.
+  Clock::duration idleFor() const {
+    return Clock::now() -
+           Clock::time_point(
+               Clock::duration(last_used_.load(std::memory_order_relaxed)));
+  }
+
+  // How long the last wake from hibernation took, or -1 if there was none.
+  std::int64_t lastRehydrationMs() const {
+    return last_rehydration_ms_.load(std::memory_order_relaxed);
+  }
+
+  // Unloads the index unless a caller holds a pin; never waits for one.
+  bool evictIndex() { return unloadAndRelease(false); }
+
+  // Same contract as evictIndex(), but also applies to an index that is
+  // already evicted or was never loaded.
+  bool hibernate() { return unloadAndRelease(true); }
+
+protected:
+  explicit OssecResidencyMixin(ResidencyBudget *budget) : budget_(budget) {
+    touch();
+  }
+
+  // For containers whose index is built in the constructor.
+  void markResident() {
+    resident_.store(true, std::memory_order_seq_cst);
+    touch();
+    setResidency(container::Running{});
+    chargeBudget();
+  }
+
+  // Reports Loading while `step` runs, e.g. start-up work outside the index,
+  // then whatever was reported before. Activation and hibernation wait for it.
+  template <typename Step> auto whileLoading(Step &&step) {
+    std::lock_guard activation(activation_mutex_);
+    StateVariant previous;
+    {
+      std::lock_guard lock(state_mutex_);
+      previous = std::exchange(residency_, container::Loading{});
+    }
+    try {
+      auto result = step();
+      setResidency(previous);
+      return result;
+    } catch (...) {
+      setResidency(previous);
+      throw;
+    }
+  }
+
+  // Must run before Derived's members are destroyed: an eviction pass on
+  // another thread may otherwise reach them.
+  void leaveBudget() {
+    if (budget_) {
+      budget_->release(this);
+    }
+  }
+
+private:
+  void activateIndex() {
+    {
+      std::lock_guard lock(activation_mutex_);
+      if (resident_.load(std::memory_order_seq_cst)) {
+        return;
+      }
+
+      const auto started = Clock::now();
+      const bool waking = isHibernated();
+      setResidency(container::Loading{});
+      if (waking) {
+        derived().wakeIndex();
+      }
+      derived().loadIndex();
+      hibernated_.store(false, std::memory_order_release);
+      setResidency(container::Running{});
+      resident_.store(true, std::memory_order_seq_cst);
+      touch();
+
+      const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          Clock::now() - started)
+                          .count();
+      if (waking) {
+        last_rehydration_ms_.store(ms, std::memory_order_relaxed);
+        spdlog::info("Container {} rehydrated in {} ms", derived().getId(),
+                     ms);
+      } else {
+        spdlog::info("Index for {} activated in {} ms", derived().getId(), ms);
+      }
+    }
+    chargeBudget();
+  }
+
+  bool unloadAndRelease(bool hibernate) {
+    if (!unloadIndex(hibernate)) {
+      return false;
+    }
+    if (budget_) {
+      budget_->release(this);
+    }
+    return true;
+  }
+
+  // Clearing the flag before reading the pin count pairs with pinIndex()
+  // raising the count before reading the flag: one of the two sees the other.
+  // An index that is not resident has no pins to check: pinIndex() drops its
+  // pin and waits on activation_mutex_, which is held here.
+  bool unloadIndex(bool hibernate = false) {
+    std::unique_lock lock(activation_mutex_, std::try_to_lock);
+    if (!lock.owns_lock() || isHibernated()) {
+      return false;
+    }
+
+    const bool resident = resident_.load(std::memory_order_seq_cst);
+    if (!resident && !hibernate) {
+      return false;
+    }
+    if (resident) {
+      resident_.store(false, std::memory_order_seq_cst);
+      if (pins_.load(std::memory_order_seq_cst) != 0) {
+        resident_.store(true, std::memory_order_seq_cst);
+        return false;
+      }
+      derived().releaseIndex();
+    }
+
+    if (hibernate) {
+      derived().hibernateIndex();
+      hibernated_.store(true, std::memory_order_release);
+      spdlog::info("Container {} hibernated", derived().getId());
+    } else {
+      spdlog::info("Index for {} evicted", derived().getId());
+    }
+    setResidency(container::Stopped{});
+    return true;
+  }
+
+  void chargeBudget() {
+    if (budget_) {
+      budget_->charge(this, derived().indexBytes(), last_used_,
+                      [this] { return unloadIndex(); });
+    }
+  }
+
+  void setResidency(StateVariant state) {
+    std::lock_guard lock(state_mutex_);
+    residency_ = state;
+  }
+
+  void touch() {
+    last_used_.store(Clock::now().time_since_epoch().count(),
+                     std::memory_order_relaxed);
+  }
+
+  const Derived &derived() const { return static_cast<const Derived &>(*this); }
+  Derived &derived() { return static_cast<Derived &>(*this); }
+
+  ResidencyBudget *budget_;
+  // Serialises activation and unloading; state_mutex_ only guards the state
+  // so that it can be read while an activation runs.
+  std::mutex activation_mutex_;
+  mutable std::mutex state_mutex_;
+  StateVariant residency_{container::Unknown{}};
+  std::atomic<bool> resident_{false};
+  std::atomic<std::size_t> pins_{0};
+  std::atomic<Clock::rep> last_used_{0};
+  std::atomic<bool> hibernated_{false};
+  std::atomic<std::int64_t> last_rehydration_ms_{-1};
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_CONTAINER_MIXINS_OSSEC_RESIDENCY
@@ -1,6 +1,7 @@
 #ifndef OWL_VFS_CORE_CONTAINER_MIXINS_OSSEC_RESOURCES
 #define OWL_VFS_CORE_CONTAINER_MIXINS_OSSEC_RESOURCES
 
+#include <filesystem>
 #include <sstream>
 #include <string>
 
@@ -71,6 +72,14 @@ public:
     return core::Result<std::string, Error>::Ok(ss.str());
   }
 
+  // Empty when the container has no cgroup.
+  std::filesystem::path getCgroupPath() const {
+    if (!derived().getNative()) {
+      return {};
+    }
+    return derived().getNative()->get_container().cgroup_path;
+  }
+
 private:
   core::Result<void> setMemoryLimit(const std::string &mb_value) {
     auto &cont = derived().getNative()->get_container();
@@ -1,8 +1,14 @@
 #ifndef OWL_VFS_CORE_CONTAINER_MIXINS_OSSEC_SEARCH
 #define OWL_VFS_CORE_CONTAINER_MIXINS_OSSEC_SEARCH
 
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -10,9 +16,35 @@
 #include <spdlog/spdlog.h>
 
 #include "ossec_fs_helpers.hpp"
+#include "vfs/core/index/access_trainer.hpp"
+#include "vfs/core/index/embedding.hpp"
+#include "vfs/core/index/hub_rank.hpp"
+#include "vfs/core/index/keyword_index.hpp"
+#include "vfs/core/index/knn_graph.hpp"
+#include "vfs/core/index/passage_chunker.hpp"
+#include "vfs/core/index/passage_index.hpp"
+#include "vfs/core/index/rank_fusion.hpp"
+#include "vfs/core/index/related_files.hpp"
+#include "vfs/core/index/rerank.hpp"
+#include "vfs/core/index/search_filter.hpp"
+#include "vfs/core/index/versioned_vector_index.hpp"
 
 namespace owl {
 
+// Deferred skips feeding chunkees at construction; warmSearch() does it later.
+// Used by clones, which are searchable from the vector snapshot right away.
+// Lazy builds nothing at construction: the index is activated on first use
+// (see OssecResidencyMixin).
+enum class SearchWarmup { Eager, Deferred, Lazy };
+
+// Optional extras for a query: a precomputed (e.g. cached) query vector,
+// per-query ANN tuning and a metadata filter.
+struct QueryOptions {
+  const std::vector<float> *embedding = nullptr;
+  VectorSearchParams tuning;
+  SearchFilter filter;
+};
+
 template <typename Derived>
 class OssecSearchMixin : 
                          public SearchableContainer<Derived> {
@@ -20,12 +52,18 @@ public:
   using Error = std::runtime_error;
 
   core::Result<std::vector<std::pair<std::string, float>>>
-  semanticSearch(const std::string &query, int limit) {
-    recordSearchQuery(query);
-
-    auto &search = derived().search();
+  semanticSearch(const std::string &query, int limit,
+                 const QueryOptions &options = {}) {
+    const auto pin = derived().pinIndex();
+    if (auto out = vectorSearch(query, limit, options)) {
+      recordQuery(query, *out, "semantic_search");
+      return core::Result<std::vector<std::pair<std::string, float>>,
+                          Error>::Ok(std::move(*out));
+    }
 
-    auto r = search.hybridSemanticSearch(query, limit);
+    auto lock = lockSearch();
+    auto r = derived().search().hybridSemanticSearch(
+        query, options.filter.empty() ? limit : std::max(limit * 3, kFusionDepth));
     if (!r.is_ok()) {
       return core::Result<std::vector<std::pair<std::string, float>>,
                           Error>::Error(Error("semanticSearch error: " +
@@ -33,24 +71,196 @@ public:
     }
 
     std::vector<std::pair<std::string, float>> out;
-    const auto &res = r.value();
-    out.reserve(res.size());
-
-    for (const auto &[file_path, score] : res) {
+    out.reserve(r.value().size());
+    for (const auto &[file_path, score] : r.value()) {
       out.emplace_back(file_path, score);
-      recordFileAccess(file_path, "semantic_search");
     }
+    out = filterHits(std::move(out), options.filter);
+    recordQuery(query, out, "semantic_search");
     return core::Result<std::vector<std::pair<std::string, float>>, Error>::Ok(
         std::move(out));
   }
 
+  // One matrix search over the current snapshot for all queries. `embeddings`
+  // may carry cached vectors (null entries are embedded here); without a
+  // vector index every query, and with one every query that cannot be
+  // embedded, falls back to semanticSearch().
+  core::Result<std::vector<std::vector<std::pair<std::string, float>>>>
+  semanticSearchBatch(const std::vector<std::string> &queries, int limit,
+                      const std::vector<const std::vector<float> *> &embeddings =
+                          {},
+                      const VectorSearchParams &tuning = {}) {
+    const auto pin = derived().pinIndex();
+    using Batch = std::vector<std::vector<std::pair<std::string, float>>>;
+
+    const auto vectors = derived().vectors().snapshot();
+    if (vectors->size() == 0) {
+      Batch out;
+      out.reserve(queries.size());
+      for (std::size_t i = 0; i < queries.size(); ++i) {
+        auto r = semanticSearch(queries[i], limit, {nullptr, tuning});
+        if (!r.is_ok()) {
+          return core::Result<Batch, Error>::Error(r.error());
+        }
+        out.push_back(std::move(r.value()));
+      }
+      return core::Result<Batch, Error>::Ok(std::move(out));
+    }
+
+    std::vector<std::vector<float>> matrix(queries.size());
+    std::vector<bool> unembedded(queries.size(), false);
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+      if (i < embeddings.size() && embeddings[i]) {
+        matrix[i] = *embeddings[i];
+      } else if (auto embedded = embedText(derived().embedder(), queries[i]);
+                 embedded.is_ok()) {
+        matrix[i] = std::move(embedded.value());
+      } else {
+        spdlog::debug("semanticSearchBatch: {}", embedded.error().what());
+        unembedded[i] = true;
+      }
+    }
+
+    auto out = vectors->searchBatch(
+        matrix, static_cast<std::size_t>(std::max(limit, 0)), tuning);
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+      if (!unembedded[i]) {
+        recordQuery(queries[i], out[i], "semantic_search_batch");
+        continue;
+      }
+      auto r = semanticSearch(queries[i], limit, {nullptr, tuning});
+      if (!r.is_ok()) {
+        return core::Result<Batch, Error>::Error(r.error());
+      }
+      out[i] = std::move(r.value());
+    }
+    return core::Result<Batch, Error>::Ok(std::move(out));
+  }
+
+  // Passage-level semantic search: the best matching byte ranges, possibly
+  // several from one file. Needs no lock, like vectorSearch().
+  core::Result<std::vector<PassageHit>>
+  passageSearch(const std::string &query, int limit,
+                const QueryOptions &options = {}) {
+    const auto pin = derived().pinIndex();
+    const auto k = static_cast<std::size_t>(std::max(limit, 0));
+    if (!options.filter.matchesLabels(derived().getLabels())) {
+      return core::Result<std::vector<PassageHit>, Error>::Ok({});
+    }
+
+    // Passage keys start with the file path, so the prefix test carries over;
+    // per-file metadata is not kept for passages.
+    SearchFilter filter;
+    filter.path_prefix = options.filter.path_prefix;
+
+    if (options.embedding) {
+      return core::Result<std::vector<PassageHit>, Error>::Ok(
+          derived().passages().search(*options.embedding, k, options.tuning,
+                                      filter));
+    }
+
+    auto embedded = embedText(derived().embedder(), query);
+    if (!embedded.is_ok()) {
+      return core::Result<std::vector<PassageHit>, Error>::Error(
+          Error("passageSearch error: " +
+                std::string(embedded.error().what())));
+    }
+    return core::Result<std::vector<PassageHit>, Error>::Ok(
+        derived().passages().search(embedded.value(), k, options.tuning,
+                                    filter));
+  }
+
+  // The keyword index has no metadata columns, so a filter is applied to a
+  // deeper candidate list.
+  core::Result<std::vector<std::pair<std::string, float>>>
+  keywordSearch(const std::string &query, int limit,
+                const SearchFilter &filter = {}) {
+    const auto pin = derived().pinIndex();
+    const int depth = filter.empty() ? limit : std::max(limit * 3, kFusionDepth);
+    auto hits = derived().keywordIndex().search(
+        query, static_cast<std::size_t>(std::max(depth, 0)));
+    hits = filterHits(std::move(hits), filter);
+    if (hits.size() > static_cast<std::size_t>(std::max(limit, 0))) {
+      hits.resize(static_cast<std::size_t>(std::max(limit, 0)));
+    }
+    recordQuery(query, hits, "keyword_search");
+    return core::Result<std::vector<std::pair<std::string, float>>, Error>::Ok(
+        std::move(hits));
+  }
+
+  // Both rankers are asked for a deeper candidate list than the caller wants
+  // so that documents ranked moderately by each can still win after fusion.
+  core::Result<std::vector<std::pair<std::string, float>>>
+  fusedSearch(const std::string &query, int limit,
+              const QueryOptions &options = {}) {
+    const auto pin = derived().pinIndex();
+    const int depth = std::max(limit * 3, kFusionDepth);
+
+    std::vector<std::pair<std::string, float>> vector_hits;
+    if (auto hits = vectorSearch(query, depth, options)) {
+      vector_hits = std::move(*hits);
+    } else {
+      auto lock = lockSearch();
+      auto semantic = derived().search().hybridSemanticSearch(query, depth);
+      if (semantic.is_ok()) {
+        for (const auto &[file_path, score] : semantic.value()) {
+          vector_hits.emplace_back(file_path, score);
+        }
+        vector_hits = filterHits(std::move(vector_hits), options.filter);
+      } else {
+        spdlog::warn("fusedSearch: semantic side failed: {}",
+                     semantic.error().what());
+      }
+    }
+
+    const auto keyword_hits = filterHits(
+        derived().keywordIndex().search(query, static_cast<std::size_t>(depth)),
+        options.filter);
+
+    auto out = reciprocalRankFusion(
+        {&vector_hits, &keyword_hits},
+        static_cast<std::size_t>(std::max(limit, 0)));
+    recordQuery(query, out, "fused_search");
+    return core::Result<std::vector<std::pair<std::string, float>>, Error>::Ok(
+        std::move(out));
+  }
+
+  core::Result<std::vector<std::pair<std::string, float>>>
+  searchWithMode(const std::string &query, int limit, SearchMode mode,
+                 const QueryOptions &options = {}) {
+    switch (mode) {
+    case SearchMode::Keyword:
+      return keywordSearch(query, limit, options.filter);
+    case SearchMode::Fused:
+      return fusedSearch(query, limit, options);
+    case SearchMode::Semantic:
+      break;
+    }
+    return semanticSearch(query, limit, options);
+  }
+
+  // The owl vector index boosted by PageRank over relations(), which every
+  // write keeps current. chunkees' relationship pass only runs on bulk
+  // paths, so it answers only while the vector index cannot.
   core::Result<std::vector<std::pair<std::string, float>>>
   enhancedSemanticSearch(const std::string &query, int limit) {
+    const auto pin = derived().pinIndex();
+    if (auto hits = vectorSearch(query, std::max(limit * 3, kFusionDepth))) {
+      const auto ranking = derived().hubRank().ranking(derived().relations());
+      auto out = rerankByHubs(*hits, *ranking,
+                              static_cast<std::size_t>(std::max(limit, 0)));
+      recordQuery(query, out, "enhanced_search");
+      return core::Result<std::vector<std::pair<std::string, float>>, Error>::Ok(
+          std::move(out));
+    }
+
+    auto lock = lockSearch();
     recordSearchQuery(query);
 
     auto &search = derived().search();
     auto r = search.enhancedSemanticSearch(query, limit);
     if (!r.is_ok()) {
+      lock.unlock();
       return semanticSearch(query, limit);
     }
 
@@ -63,13 +273,38 @@ public:
         std::move(out));
   }
 
+  // Served from the materialised related-files table when the file has an
+  // entry, else straight from relations() until the refresh reaches it;
+  // chunkees and the access model only answer for files without a vector.
   core::Result<std::vector<std::string>>
   getRecommendations(const std::string &current_file, int limit) {
+    const auto pin = derived().pinIndex();
     recordFileAccess(current_file, "recommendation_request");
+    if (auto related = derived().related().lookup(current_file)) {
+      auto paths = pathsOf(related->files);
+      if (static_cast<int>(paths.size()) > limit) {
+        paths.resize(static_cast<std::size_t>(std::max(limit, 0)));
+      }
+      return core::Result<std::vector<std::string>, Error>::Ok(
+          std::move(paths));
+    }
+    if (derived().relations().contains(current_file)) {
+      return core::Result<std::vector<std::string>, Error>::Ok(
+          pathsOf(derived().relations().neighbors(
+              current_file, static_cast<std::size_t>(std::max(limit, 0)))));
+    }
+
+    auto lock = lockSearch();
 
     auto &search = derived().search();
     auto r = search.getRecommendations(current_file);
     if (!r.is_ok()) {
+      if (auto next = derived().accessModel().successors(
+              current_file, static_cast<std::size_t>(std::max(limit, 0)));
+          !next.empty()) {
+        return core::Result<std::vector<std::string>, Error>::Ok(
+            pathsOf(next));
+      }
       auto predictions = search.predictNextFiles();
       if (predictions.is_ok()) {
         auto v = predictions.value();
@@ -90,7 +325,16 @@ public:
         std::move(recommendations));
   }
 
-  core::Result<std::vector<std::string>> predictNextFiles(int /*limit*/) {
+  // From the online access model; chunkees' HMM answers until it has data.
+  core::Result<std::vector<std::string>> predictNextFiles(int limit) {
+    const auto pin = derived().pinIndex();
+    if (auto next = derived().accessModel().predict(
+            static_cast<std::size_t>(std::max(limit, 0)));
+        !next.empty()) {
+      return core::Result<std::vector<std::string>, Error>::Ok(pathsOf(next));
+    }
+
+    auto lock = lockSearch();
     auto &search = derived().search();
     auto r = search.predictNextFiles();
     if (!r.is_ok()) {
@@ -100,7 +344,43 @@ public:
     return core::Result<std::vector<std::string>, Error>::Ok(r.value());
   }
 
+  // The materialised list behind getRecommendations() and user.owl.related;
+  // null until the background refresh has reached the file. Never pins, so
+  // listing xattrs on a stub or evicted container does not load its index:
+  // it answers null until something else has.
+  RelatedFiles::Entry relatedFiles(const std::string &virtual_path) const {
+    if (!derived().isResident()) {
+      return nullptr;
+    }
+    return derived().related().lookup(virtual_path);
+  }
+
+  // Nearest files to `virtual_path` in the relationship graph.
+  core::Result<std::vector<std::pair<std::string, float>>>
+  semanticNeighbors(const std::string &virtual_path, int count) {
+    const auto pin = derived().pinIndex();
+    return core::Result<std::vector<std::pair<std::string, float>>, Error>::Ok(
+        derived().relations().neighbors(
+            virtual_path, static_cast<std::size_t>(std::max(count, 0))));
+  }
+
+  // PageRank over relations(), recomputed only when the graph has changed.
+  // chunkees answers while no file has a vector yet.
   core::Result<std::vector<std::string>> getSemanticHubs(int count) {
+    const auto pin = derived().pinIndex();
+    const auto ranking = derived().hubRank().ranking(derived().relations());
+    if (!ranking->ranked.empty()) {
+      std::vector<std::string> hubs;
+      const auto n = std::min(ranking->ranked.size(),
+                              static_cast<std::size_t>(std::max(count, 0)));
+      hubs.reserve(n);
+      for (std::size_t i = 0; i < n; ++i) {
+        hubs.push_back(ranking->ranked[i].first);
+      }
+      return core::Result<std::vector<std::string>, Error>::Ok(std::move(hubs));
+    }
+
+    auto lock = lockSearch();
     auto &search = derived().search();
     auto r = search.getSemanticHubs(count);
     if (!r.is_ok()) {
@@ -111,17 +391,21 @@ public:
   }
 
   core::Result<std::string> classifyFile(const std::string &file_path) {
+    const auto pin = derived().pinIndex();
+    auto lock = lockSearch();
     auto &search = derived().search();
     std::string category = search.classifyFileCategory(file_path);
     return core::Result<std::string, Error>::Ok(std::move(category));
   }
 
   core::Result<void> updateAllEmbeddings() {
+    const auto pin = derived().pinIndex();
     auto files_res = derived().listFiles("/");
     if (!files_res.is_ok()) {
       return core::Result<void, Error>::Error(files_res.error());
     }
 
+    auto lock = lockSearch();
     auto &search = derived().search();
     const auto &files = files_res.value();
 
@@ -135,10 +419,18 @@ public:
     }
 
     rebuildSearchIndexWithRelationships();
+    derived().bumpSearchGeneration();
     return core::Result<void, Error>::Ok();
   }
 
   core::Result<std::string> getSearchInfo() const {
+    auto lock = lockSearch();
+    if (!derived().hasSearch()) {
+      std::stringstream ss;
+      ss << "Search Info for Container " << derived().getId() << ":\n";
+      ss << "  Residency: " << derived().getResidency() << "\n";
+      return core::Result<std::string, Error>::Ok(ss.str());
+    }
     auto &search = derived().search();
 
     auto file_count = search.getIndexedFilesCount();
@@ -146,16 +438,44 @@ public:
 
     std::stringstream ss;
     ss << "Search Info for Container " << derived().getId() << ":\n";
+    ss << "  Residency: " << derived().getResidency() << "\n";
+    if (const auto ms = derived().lastRehydrationMs(); ms >= 0) {
+      ss << "  Last Rehydration: " << ms << " ms\n";
+    }
     ss << "  Indexed Files: " << (file_count.is_ok() ? file_count.value() : 0)
        << "\n";
     ss << "  Recent Queries: "
        << (recent_queries.is_ok() ? recent_queries.value() : 0) << "\n";
+    const auto vectors = derived().vectors().snapshot();
+    ss << "  Vectors: " << vectors->size() << " (" << vectors->factory()
+       << ", generation " << vectors->generation() << ")\n";
+    if (vectors->reranked()) {
+      ss << "  Exact Re-rank: " << vectors->exactSize()
+         << " float32 vectors on disk\n";
+    }
+    if (const auto recall = vectors->recall()) {
+      ss << "  Recall@" << VectorIndex::kRecallDepth << ": " << recall->raw
+         << " raw, " << recall->reranked << " re-ranked (" << recall->queries
+         << " queries at build)\n";
+    }
+    ss << "  Relation Graph: " << derived().relations().size()
+       << " files (version " << derived().relations().version() << ")\n";
+    ss << "  Access Model: " << derived().accessModel().size() << " files, "
+       << derived().accessTrainer().applied() << " events applied, "
+       << derived().accessTrainer().dropped() << " dropped\n";
+    ss << "  Passages: " << derived().passages().size() << " in "
+       << derived().passages().fileCount() << " files\n";
+    ss << "  Keyword Documents: " << derived().keywordIndex().size() << "\n";
+    ss << "  Keyword Postings: " << derived().keywordIndex().postingBytes()
+       << " bytes\n";
     ss << "  Embedder: " << search.getEmbedderInfo() << "\n";
+    ss << "  SIMD: " << simd::levelName(simd::kernels().level) << "\n";
 
     return core::Result<std::string, Error>::Ok(ss.str());
   }
 
   core::Result<void> recordSearchQuery(const std::string &query) {
+    const auto pin = derived().pinIndex();
     auto &search = derived().search();
     auto r = search.getRecentQueries();
     if (!r.is_ok()) {
@@ -169,84 +489,486 @@ public:
   core::Result<void> indexFileInSearch(const std::string &virtual_path,
                                        const std::string &content,
                                        const std::string &access_reason) {
-    auto &search = derived().search();
+    const auto pin = derived().pinIndex();
+    StringSource source(content);
+    auto ingested = ingestFile(virtual_path, source, {});
 
-    auto r = search.addFile(virtual_path, content);
-    if (!r.is_ok()) {
-      return core::Result<void, Error>::Error(
-          Error("search::addFile failed: " + std::string(r.error().what())));
+    auto indexed = core::Result<void, Error>::Ok();
+    FileMeta meta;
+    {
+      auto lock = lockSearch();
+      auto &search = derived().search();
+
+      auto r = search.addFile(virtual_path, content);
+      if (r.is_ok()) {
+        rebuildSearchIndex();
+        recordFileAccess(virtual_path, access_reason);
+      } else {
+        indexed = core::Result<void, Error>::Error(
+            Error("search::addFile failed: " + std::string(r.error().what())));
+      }
+      meta = describeFile(virtual_path);
     }
 
-    rebuildSearchIndexWithRelationships();
-    recordFileAccess(virtual_path, access_reason);
+    if (ingested.vector) {
+      upsertVector(virtual_path, std::move(*ingested.vector), std::move(meta));
+    } else {
+      spdlog::warn("Failed to embed {}", virtual_path);
+    }
 
-    return core::Result<void, Error>::Ok();
+    derived().bumpSearchGeneration();
+    return indexed;
   }
 
   core::Result<void> removeFileFromSearch(const std::string &virtual_path) {
+    const auto pin = derived().pinIndex();
+    derived().keywordIndex().remove(virtual_path);
+    derived().vectors().remove(virtual_path);
+    derived().related().erase(virtual_path);
+    markRelated(derived().relations().erase(virtual_path));
+    derived().accessModel().forget(virtual_path);
+    derived().passages().remove(virtual_path);
+
+    auto lock = lockSearch();
     auto &search = derived().search();
 
     auto r = search.removeFile(virtual_path);
     if (!r.is_ok()) {
       spdlog::warn("Failed to remove from index: {}", r.error().what());
     }
-
-    search.updateSemanticRelationships();
+    derived().bumpSearchGeneration();
     return core::Result<void, Error>::Ok();
   }
 
-  void rebuildSearchIndexWithRelationships() {
-    auto &search = derived().search();
-
-    search.updateSemanticRelationships();
-    auto rebuild = search.rebuildIndex();
+  // Callers must hold lockSearch().
+  void rebuildSearchIndex() {
+    auto rebuild = derived().search().rebuildIndex();
     if (!rebuild.is_ok()) {
       spdlog::warn("Failed to rebuild index: {}", rebuild.error().what());
     }
   }
 
-  void initializeSearchIndexFromFs() {
-    auto files_res = derived().listFiles("/");
-    if (!files_res.is_ok()) {
-      spdlog::warn("initializeSearch: {}", files_res.error().what());
-      return;
+  // Bulk paths only (start-up, warm-up, import): chunkees' relationship pass
+  // walks every file. Single-file changes update relations() instead.
+  // Callers must hold lockSearch().
+  void rebuildSearchIndexWithRelationships() {
+    derived().search().updateSemanticRelationships();
+    rebuildSearchIndex();
+  }
+
+  // Callers must hold lockSearch(); the category comes from chunkees.
+  FileMeta describeFile(const std::string &virtual_path) {
+    FileMeta meta;
+    try {
+      meta.category = derived().search().classifyFileCategory(virtual_path);
+    } catch (const std::exception &e) {
+      spdlog::debug("No category for {}: {}", virtual_path, e.what());
+    }
+
+    std::error_code ec;
+    const auto time = fs::last_write_time(
+        fs::path(derived().getDataPath()) / fs::path(virtual_path).relative_path(),
+        ec);
+    if (!ec) {
+      meta.mtime = epochSeconds(time);
+    }
+    return meta;
+  }
+
+  void upsertVector(const std::string &virtual_path, std::vector<float> vector,
+                    const FileMeta &meta = {}) {
+    markRelated(derived().relations().insert(virtual_path, vector.data(),
+                                             vector.size()));
+    auto r = derived().vectors().upsert(virtual_path, std::move(vector), meta);
+    if (!r.is_ok()) {
+      spdlog::warn("Failed to store vector for {}: {}", virtual_path,
+                   r.error().what());
+    }
+  }
+
+  // What one streamed pass over a file's text feeds. The keyword index is
+  // always fed; the file vector, if asked for, is the length-weighted mean of
+  // the passage vectors.
+  struct Ingest {
+    bool vector = true;
+    bool passages = true;
+    bool search_text = false;
+  };
+
+  struct Ingested {
+    std::optional<std::vector<float>> vector;
+    // The first kSearchTextLimit bytes, for chunkees.
+    std::string search_text;
+  };
+
+  // Reads `source` once, a passage at a time, so a large file is never held
+  // whole. Passages go to the passage index kPassageBatch at a time.
+  template <typename Source>
+  Ingested ingestFile(const std::string &virtual_path, Source &source,
+                      const Ingest &what) {
+    Ingested out;
+    KeywordIndex::Terms terms;
+    std::vector<float> sum;
+    PassageIndex::Embedded batch;
+    bool first = true;
+    const auto flush = [&]() {
+      auto r = first ? derived().passages().replace(virtual_path, std::move(batch))
+                     : derived().passages().append(virtual_path, std::move(batch));
+      if (!r.is_ok()) {
+        spdlog::warn("Failed to store passages for {}: {}", virtual_path,
+                     r.error().what());
+      }
+      batch.clear();
+      first = false;
+    };
+
+    kPassageChunker.chunk(source, [&](Passage passage) {
+      terms.add(passage.text);
+      if (what.search_text && out.search_text.size() < kSearchTextLimit) {
+        out.search_text.append(passage.text, 0,
+                               kSearchTextLimit - out.search_text.size());
+      }
+      if (!what.vector && !what.passages) {
+        return;
+      }
+
+      auto vector = embedText(derived().embedder(), passage.text);
+      if (!vector.is_ok()) {
+        spdlog::debug("Failed to embed passage of {}: {}", virtual_path,
+                      vector.error().what());
+        return;
+      }
+      if (what.vector) {
+        const auto &v = vector.value();
+        if (sum.empty()) {
+          sum.assign(v.size(), 0.0f);
+        }
+        if (sum.size() == v.size()) {
+          simd::kernels().fuse(sum.data(), 1.0f, v.data(),
+                               static_cast<float>(passage.length), sum.data(),
+                               sum.size());
+        }
+      }
+      if (what.passages) {
+        passage.text.clear();
+        batch.emplace_back(std::move(passage), std::move(vector.value()));
+        if (batch.size() >= kPassageBatch) {
+          flush();
+        }
+      }
+    });
+    if (what.passages && (first || !batch.empty())) {
+      flush();
+    }
+
+    derived().keywordIndex().add(virtual_path, terms);
+    if (!sum.empty()) {
+      out.vector = std::move(sum);
     }
+    return out;
+  }
 
+  core::Result<void> persistVectorIndex() {
+    auto r = derived().vectors().save(derived().stateDir());
+    if (!r.is_ok()) {
+      spdlog::warn("Failed to persist vectors for {}: {}", derived().getId(),
+                   r.error().what());
+      return r;
+    }
+    r = derived().passages().save(derived().stateDir());
+    if (!r.is_ok()) {
+      spdlog::warn("Failed to persist passages for {}: {}", derived().getId(),
+                   r.error().what());
+    }
+    return r;
+  }
+
+  // Loads the vector snapshot from stateDir() and only embeds files that are
+  // missing from it or changed after it was written. Each file is streamed
+  // once through ingestFile(), so memory stays bounded however large it is.
+  void initializeSearchIndexFromFs(SearchWarmup warmup = SearchWarmup::Eager) {
+    auto lock = lockSearch();
     auto &search = derived().search();
-    const auto &files = files_res.value();
 
-    for (const auto &file : files) {
+    const fs::path data_path = derived().getDataPath();
+    const auto index_config =
+        IndexConfig::load(data_path / "container_config.json");
+    derived().vectors().configure(index_config);
+    derived().passages().configure(index_config);
+
+    const auto state_dir = derived().stateDir();
+    const auto snapshot_time = VectorIndex::snapshotTime(state_dir);
+    const auto passages_time = PassageIndex::snapshotTime(state_dir);
+    derived().passages().load(state_dir);
+    if (auto snapshot = VectorIndex::load(state_dir); snapshot.is_ok()) {
+      derived().vectors().reset(snapshot.value());
+      spdlog::info("Loaded {} vectors for {} from snapshot",
+                   snapshot.value()->size(), derived().getId());
+    }
+    if (auto r = derived().vectors().attach(state_dir); !r.is_ok()) {
+      spdlog::warn("No exact vector store for {}: {}", derived().getId(),
+                   r.error().what());
+    }
+
+    std::unordered_set<std::string> present;
+    std::vector<std::pair<std::string, FileMeta>> undescribed;
+    std::size_t embedded = 0;
+
+    for (const auto &file : derived().pathIndex().paths()) {
+      const std::string path = "/" + file;
+      present.insert(path);
+
+      std::error_code ec;
+      const auto mtime = fs::last_write_time(data_path / file, ec);
+      const bool stale_vector =
+          !derived().vectors().snapshot()->contains(path) ||
+          mtime > snapshot_time;
+      const bool stale_passages =
+          !derived().passages().contains(path) || mtime > passages_time;
+
+      FileSource source((data_path / file).string());
+      if (!source.good()) {
+        spdlog::warn("Failed to open {} for indexing", path);
+        continue;
+      }
+      auto ingested = ingestFile(
+          path, source,
+          {stale_vector, stale_passages, warmup == SearchWarmup::Eager});
+
+      if (warmup == SearchWarmup::Eager) {
+        auto r = search.addFile(path, ingested.search_text);
+        if (r.is_ok()) {
+          recordFileAccess(path, "read");
+        } else {
+          spdlog::warn("Failed to index file {}: {}", path, r.error().what());
+        }
+      }
+
+      if (stale_vector) {
+        if (ingested.vector) {
+          upsertVector(path, std::move(*ingested.vector), describeFile(path));
+          ++embedded;
+        }
+      } else if (derived().vectors().snapshot()->meta(path)->mtime == 0) {
+        undescribed.emplace_back(path, describeFile(path));
+      }
+      if (stale_passages) {
+        ++embedded;
+      }
+    }
+
+    if (!undescribed.empty()) {
+      derived().vectors().annotate(undescribed);
+      embedded += undescribed.size();
+    }
+
+    for (const auto &path : derived().vectors().snapshot()->paths()) {
+      if (!present.count(path)) {
+        derived().vectors().remove(path);
+        ++embedded;
+      }
+    }
+    loadRelations();
+    for (const auto &path : derived().passages().files()) {
+      if (!present.count(path)) {
+        derived().passages().remove(path);
+        ++embedded;
+      }
+    }
+
+    if (warmup == SearchWarmup::Eager) {
+      rebuildSearchIndexWithRelationships();
+    }
+    if (embedded > 0) {
+      persistVectorIndex();
+    }
+  }
+
+  // Feeds chunkees for a container constructed with SearchWarmup::Deferred.
+  void warmSearch() {
+    const auto pin = derived().pinIndex();
+    const auto started = std::chrono::steady_clock::now();
+    auto lock = lockSearch();
+    auto &search = derived().search();
+
+    for (const auto &file : derived().pathIndex().paths()) {
       const std::string path = "/" + file;
       auto content_res = derived().getFileContent(path);
       if (!content_res.is_ok()) {
-        spdlog::warn("Failed to get content for {}: {}", path,
-                     content_res.error().what());
         continue;
       }
 
       auto r = search.addFile(path, content_res.value());
-      if (r.is_ok()) {
-        recordFileAccess(path, "read");
-      } else {
+      if (!r.is_ok()) {
         spdlog::warn("Failed to index file {}: {}", path, r.error().what());
       }
     }
 
     rebuildSearchIndexWithRelationships();
+    derived().bumpSearchGeneration();
+    spdlog::info("Search for {} warmed in {} ms", derived().getId(),
+                 std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::steady_clock::now() - started)
+                     .count());
   }
 
 protected:
+  std::unique_lock<std::mutex> lockSearch() const {
+    return std::unique_lock<std::mutex>(derived().searchMutex());
+  }
+
+  // Never blocks: the event is queued for the container's AccessTrainer,
+  // which feeds applyAccesses() from its own thread.
   void recordFileAccess(const std::string &file_path,
                         const std::string &operation) {
+    derived().accessTrainer().record(file_path, operation);
+  }
+
+  // Trainer thread. The owl model is updated without lockSearch(); chunkees'
+  // predictors take one lock per batch instead of one per event.
+  void applyAccesses(const std::vector<AccessEvent> &events) {
+    std::vector<std::string> changed;
+    for (const auto &event : events) {
+      if (auto from = derived().accessModel().observe(event)) {
+        changed.push_back(std::move(*from));
+      }
+    }
+    derived().related().invalidate(changed);
+
+    // Events queued before the container hibernated.
+    auto lock = lockSearch();
+    if (!derived().hasSearch()) {
+      return;
+    }
     auto &search = derived().search();
-    auto r = search.recordFileAccessImpl(file_path, operation);
-    if (!r.is_ok()) {
-      spdlog::debug("Failed to record file access: {} - {}", file_path,
-                    r.error().what());
+    for (const auto &event : events) {
+      auto r = search.recordFileAccessImpl(event.path, event.operation);
+      if (!r.is_ok()) {
+        spdlog::debug("Failed to record file access: {} - {}", event.path,
+                      r.error().what());
+      }
+    }
+  }
+
+  // Trainer thread: recomputes a batch of dirty related-files lists, then
+  // yields to queued access events before the next batch.
+  void refreshRelated() {
+    auto &related = derived().related();
+    for (const auto &path : related.takeDirty(kRelatedBatch)) {
+      if (!derived().relations().contains(path)) {
+        related.erase(path);
+        continue;
+      }
+      auto files = RelatedFiles::blend(
+          derived().relations().neighbors(path, RelatedFiles::kTop),
+          derived().accessModel().successors(path, RelatedFiles::kTop));
+      related.store(path, std::move(files));
+    }
+    if (related.pending() > 0) {
+      derived().accessTrainer().poke();
     }
   }
 
 private:
+  static constexpr int kFusionDepth = 50;
+  static constexpr std::size_t kPassageBatch = 256;
+  // chunkees only takes whole documents; it sees at most this much of one.
+  static constexpr std::size_t kSearchTextLimit = std::size_t{1} << 20;
+  static constexpr std::size_t kRelatedBatch = 64;
+  static inline const PassageChunker kPassageChunker{};
+
+  // The graph is not persisted: at start-up it is rebuilt from the vector
+  // snapshot, one local insert per file that upsertVector() has not added.
+  void loadRelations() {
+    const auto vectors = derived().vectors().snapshot();
+    auto &relations = derived().relations();
+    std::vector<float> buffer(vectors->dimension());
+    auto paths = vectors->paths();
+    for (const auto &path : paths) {
+      if (!relations.contains(path) &&
+          vectors->reconstruct(path, buffer.data())) {
+        relations.insert(path, buffer.data(), buffer.size());
+      }
+    }
+    markRelated(paths);
+  }
+
+  void markRelated(const std::vector<std::string> &paths) {
+    if (!paths.empty()) {
+      derived().related().invalidate(paths);
+      derived().accessTrainer().poke();
+    }
+  }
+
+
+  void recordQuery(const std::string &query,
+                   const std::vector<std::pair<std::string, float>> &hits,
+                   const char *operation) {
+    spdlog::trace("Recorded search query: {}", query);
+    for (const auto &[file_path, score] : hits) {
+      recordFileAccess(file_path, operation);
+    }
+  }
+
+  static std::vector<std::string>
+  pathsOf(const std::vector<std::pair<std::string, float>> &scored) {
+    std::vector<std::string> out;
+    out.reserve(scored.size());
+    for (const auto &[path, score] : scored) {
+      out.push_back(path);
+    }
+    return out;
+  }
+
+  std::vector<std::pair<std::string, float>>
+  filterHits(std::vector<std::pair<std::string, float>> hits,
+             const SearchFilter &filter) const {
+    if (filter.empty() && filter.labels.empty()) {
+      return hits;
+    }
+    if (!filter.matchesLabels(derived().getLabels())) {
+      return {};
+    }
+
+    const auto vectors = derived().vectors().snapshot();
+    hits.erase(std::remove_if(hits.begin(), hits.end(),
+                              [&](const auto &hit) {
+                                return !vectors->matches(hit.first, filter);
+                              }),
+               hits.end());
+    return hits;
+  }
+
+  // Runs against the current snapshot without lockSearch(). nullopt means the
+  // owl vector index cannot answer (nothing stored yet, or the query could
+  // not be embedded).
+  std::optional<std::vector<std::pair<std::string, float>>>
+  vectorSearch(const std::string &query, int limit,
+               const QueryOptions &options = {}) {
+    const auto vectors = derived().vectors().snapshot();
+    if (vectors->size() == 0) {
+      return std::nullopt;
+    }
+    if (!options.filter.matchesLabels(derived().getLabels())) {
+      return std::vector<std::pair<std::string, float>>{};
+    }
+
+    if (options.embedding) {
+      return vectors->search(*options.embedding,
+                             static_cast<std::size_t>(std::max(limit, 0)),
+                             options.tuning, options.filter);
+    }
+
+    auto embedded = embedText(derived().embedder(), query);
+    if (!embedded.is_ok()) {
+      spdlog::debug("vectorSearch: {}", embedded.error().what());
+      return std::nullopt;
+    }
+    return vectors->search(std::move(embedded.value()),
+                           static_cast<std::size_t>(std::max(limit, 0)),
+                           options.tuning, options.filter);
+  }
+
   const Derived &derived() const { return static_cast<const Derived &>(*this); }
   Derived &derived() { return static_cast<Derived &>(*this); }
 };
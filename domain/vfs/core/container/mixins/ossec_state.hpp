@@ -12,6 +12,12 @@ public:
   using Error = std::runtime_error;
 
   std::string getStatus() const {
+    if (derived().isLoading()) {
+      return "loading";
+    }
+    if (derived().isHibernated()) {
+      return "hibernated";
+    }
     auto native = derived().getNative();
     if (!native) {
       return "invalid";
@@ -27,7 +33,12 @@ public:
     return "unknown";
   }
 
+  // False while hibernated: its native side is stopped until a pin wakes
+  // it. Routes that may wake it check isHibernated() as well.
   bool isAvailable() const {
+    if (derived().isHibernated()) {
+      return false;
+    }
     auto native = derived().getNative();
     return native && native->is_running();
   }
@@ -1,8 +1,12 @@
 #ifndef OWL_VFS_CORE_CONTAINER_OSSEC_CONTAINER_HPP
 #define OWL_VFS_CORE_CONTAINER_OSSEC_CONTAINER_HPP
 
+#include <atomic>
+#include <cassert>
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -15,8 +19,20 @@
 
 #include "container_manager.hpp"
 #include "container_states.hpp"
+#include "residency.hpp"
+#include "vfs/core/index/access_model.hpp"
+#include "vfs/core/index/access_trainer.hpp"
+#include "vfs/core/index/hub_rank.hpp"
+#include "vfs/core/index/keyword_index.hpp"
+#include "vfs/core/index/knn_graph.hpp"
+#include "vfs/core/index/passage_index.hpp"
+#include "vfs/core/index/related_files.hpp"
+#include "vfs/core/index/versioned_vector_index.hpp"
+#include "vfs/core/index/trigram_index.hpp"
 
 #include "mixins/ossec_fs.hpp"
+#include "mixins/ossec_import.hpp"
+#include "mixins/ossec_residency.hpp"
 #include "mixins/ossec_resource.hpp"
 #include "mixins/ossec_search.hpp"
 #include "mixins/ossec_state.hpp"
@@ -29,17 +45,37 @@ class OssecContainer
     : public OssecFsMixin<OssecContainer<EmbedderT, SearchT>>,
       public OssecResourceMixin<OssecContainer<EmbedderT, SearchT>>,
       public OssecSearchMixin<OssecContainer<EmbedderT, SearchT>>,
+      public OssecImportMixin<OssecContainer<EmbedderT, SearchT>>,
+      public OssecResidencyMixin<OssecContainer<EmbedderT, SearchT>>,
       public OssecStateMixin<OssecContainer<EmbedderT, SearchT>> {
 public:
   using Self = OssecContainer<EmbedderT, SearchT>;
   using Error = std::runtime_error;
 
+  // With SearchWarmup::Lazy only the path index is built here: the embedder
+  // model and chunkees are not loaded until the search index is activated on
+  // first use, and are dropped again when it is evicted under `budget`.
   OssecContainer(std::shared_ptr<ossec::PidContainer> native,
-                 std::string model_path)
-      : native_(std::move(native)), embedder_manager_(std::move(model_path)),
-        search_(std::make_unique<SearchT>(embedder_manager_)),
+                 std::string model_path,
+                 SearchWarmup warmup = SearchWarmup::Eager,
+                 ResidencyBudget *budget = nullptr)
+      : OssecResidencyMixin<Self>(budget), native_(std::move(native)),
+        model_path_(std::move(model_path)), model_bytes_(modelBytes(model_path_)),
         fsm_(StateVariant{container::Unknown{}}, ContainerTransitionTable{}) {
-    OssecSearchMixin<Self>::initializeSearchIndexFromFs();
+    OssecFsMixin<Self>::initializePathIndexFromFs();
+    if (warmup != SearchWarmup::Lazy) {
+      createSearch();
+      OssecSearchMixin<Self>::initializeSearchIndexFromFs(warmup);
+      this->markResident();
+    }
+  }
+
+  ~OssecContainer() { this->leaveBudget(); }
+
+  // Start-up work after registration: the container reports Loading until
+  // its native side is running.
+  core::Result<void> bringUp() {
+    return this->whileLoading([this] { return this->ensureRunning(); });
   }
 
   // ----------- IdentifiableContainer API -----------
@@ -68,17 +104,192 @@ public:
 
   std::shared_ptr<ossec::PidContainer> getNative() const { return native_; }
 
-  EmbedderT &embedder() { return embedder_manager_; }
-  const EmbedderT &embedder() const { return embedder_manager_; }
+  // Only loaded while the index is resident; hold pinIndex() around use.
+  EmbedderT &embedder() {
+    assert(embedder_manager_ && "embedder() while not resident: pin the index");
+    return *embedder_manager_;
+  }
+  const EmbedderT &embedder() const {
+    assert(embedder_manager_ && "embedder() while not resident: pin the index");
+    return *embedder_manager_;
+  }
+
+  SearchT &search() {
+    assert(search_ && "search() while not resident: pin the index");
+    return *search_;
+  }
+  const SearchT &search() const {
+    assert(search_ && "search() while not resident: pin the index");
+    return *search_;
+  }
+
+  // False unless the index is resident. Callers must hold searchMutex().
+  bool hasSearch() const { return search_ != nullptr; }
+
+  TrigramIndex &pathIndex() { return path_index_; }
+  const TrigramIndex &pathIndex() const { return path_index_; }
+
+  std::mutex &searchMutex() const { return search_mutex_; }
+
+  fs::path stateDir() const { return fs::path(getDataPath()) / kOwlStateDir; }
+
+  // Synchronised on its own; queries read snapshots without searchMutex().
+  VersionedVectorIndex &vectors() { return vectors_; }
+  const VersionedVectorIndex &vectors() const { return vectors_; }
+
+  PassageIndex &passages() { return passages_; }
+  const PassageIndex &passages() const { return passages_; }
+
+  // File-to-file relationships; synchronised on its own like vectors().
+  KnnGraph &relations() { return relations_; }
+  const KnnGraph &relations() const { return relations_; }
+
+  HubRank &hubRank() { return hub_rank_; }
+
+  AccessModel &accessModel() { return access_model_; }
+  const AccessModel &accessModel() const { return access_model_; }
+
+  RelatedFiles &related() { return related_; }
+  const RelatedFiles &related() const { return related_; }
+
+  AccessTrainer &accessTrainer() { return access_trainer_; }
+  const AccessTrainer &accessTrainer() const { return access_trainer_; }
 
-  SearchT &search() { return *search_; }
-  const SearchT &search() const { return *search_; }
+  // Bumped by every change to the searchable content; result caches key on it.
+  std::uint64_t searchGeneration() const {
+    return search_generation_.load(std::memory_order_acquire);
+  }
+  void bumpSearchGeneration() {
+    search_generation_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  KeywordIndex &keywordIndex() { return keyword_index_; }
+  const KeywordIndex &keywordIndex() const { return keyword_index_; }
+
+  // ----------- Residency (see OssecResidencyMixin) -----------
+
+  void loadIndex() {
+    createSearch();
+    OssecSearchMixin<Self>::initializeSearchIndexFromFs(SearchWarmup::Eager);
+    bumpSearchGeneration();
+  }
+
+  // Vectors and passages are saved first; everything else, the embedder
+  // model included, is rebuilt from the files and the saved snapshots by
+  // loadIndex(). The access model is small and not persisted, so it stays.
+  void releaseIndex() {
+    this->persistVectorIndex();
+    {
+      std::lock_guard lock(search_mutex_);
+      search_.reset();
+      embedder_manager_.reset();
+    }
+    keyword_index_.clear();
+    vectors_.unload();
+    passages_.unload();
+    relations_.clear();
+    hub_rank_.clear();
+    related_.clear();
+    bumpSearchGeneration();
+  }
+
+  // After releaseIndex(), if the index was resident. The access model goes to
+  // the state directory, since loadIndex() cannot rebuild it.
+  void hibernateIndex() {
+    if (auto r = access_model_.save(stateDir()); !r.is_ok()) {
+      spdlog::warn("Failed to persist access model for {}: {}", getId(),
+                   r.error().what());
+    }
+    access_model_.clear();
+
+    resume_native_ = native_->is_running();
+    if (resume_native_) {
+      if (auto r = native_->stop(); !r.is_ok()) {
+        spdlog::warn("Failed to stop {} for hibernation: {}", getId(),
+                     r.error().what());
+      }
+    }
+  }
+
+  // Before loadIndex(), on the first pin after hibernateIndex().
+  void wakeIndex() {
+    if (resume_native_) {
+      if (auto r = this->ensureRunning(); !r.is_ok()) {
+        spdlog::warn("Failed to restart {}: {}", getId(), r.error().what());
+      }
+    }
+    if (auto r = access_model_.load(stateDir()); !r.is_ok()) {
+      spdlog::warn("Failed to load access model for {}: {}", getId(),
+                   r.error().what());
+    }
+  }
+
+  // Estimate for the ResidencyBudget of what releaseIndex() frees. The
+  // embedder counts as its model file; chunkees as one vector per file plus
+  // its own copy of the text, which the keyword postings approximate.
+  std::size_t indexBytes() const {
+    const auto vectors = vectors_.snapshot();
+    const auto passages = passages_.vectors().snapshot();
+    std::size_t search_bytes = 0;
+    {
+      std::lock_guard lock(search_mutex_);
+      if (embedder_manager_) {
+        search_bytes += model_bytes_;
+      }
+      if (search_) {
+        const auto files = search_->getIndexedFilesCount();
+        const auto count =
+            files.is_ok() ? static_cast<std::size_t>(files.value()) : 0;
+        search_bytes += count * vectors->dimension() * sizeof(float) +
+                        keyword_index_.postingBytes();
+      }
+    }
+    return (vectors->size() * vectors->dimension() +
+            passages->size() * passages->dimension()) *
+               sizeof(float) +
+           keyword_index_.postingBytes() + relations_.bytes() + search_bytes;
+  }
 
 private:
+  static std::size_t modelBytes(const std::string &model_path) {
+    std::error_code ec;
+    const auto size = fs::file_size(model_path, ec);
+    return ec ? 0 : static_cast<std::size_t>(size);
+  }
+
+  void createSearch() {
+    std::lock_guard lock(search_mutex_);
+    if (!embedder_manager_) {
+      embedder_manager_ = std::make_unique<EmbedderT>(model_path_);
+    }
+    if (!search_) {
+      search_ = std::make_unique<SearchT>(*embedder_manager_);
+    }
+  }
+
   std::shared_ptr<ossec::PidContainer> native_;
-  EmbedderT embedder_manager_;
+  std::string model_path_;
+  std::size_t model_bytes_;
+  std::unique_ptr<EmbedderT> embedder_manager_;
   std::unique_ptr<SearchT> search_;
+  bool resume_native_ = false;
+  mutable std::mutex search_mutex_;
   ContainerStateMachine fsm_;
+  TrigramIndex path_index_;
+  KeywordIndex keyword_index_;
+  VersionedVectorIndex vectors_;
+  PassageIndex passages_;
+  KnnGraph relations_;
+  HubRank hub_rank_;
+  std::atomic<std::uint64_t> search_generation_{0};
+  AccessModel access_model_;
+  RelatedFiles related_;
+  // Last, so its thread stops before anything it feeds is destroyed.
+  AccessTrainer access_trainer_{
+      [this](const std::vector<AccessEvent> &events) {
+        this->applyAccesses(events);
+      },
+      [this] { this->refreshRelated(); }};
 };
 
 } // namespace owl
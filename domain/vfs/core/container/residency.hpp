@@ -0,0 +1,136 @@
+#ifndef OWL_VFS_CORE_CONTAINER_RESIDENCY
+#define OWL_VFS_CORE_CONTAINER_RESIDENCY
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+namespace owl {
+
+// Keeps a container's index in memory while it is alive. Pins only count;
+// they nest freely and never block.
+class IndexPin {
+public:
+  explicit IndexPin(std::atomic<std::size_t> &pins) : pins_(&pins) {
+    pins.fetch_add(1, std::memory_order_seq_cst);
+  }
+
+  IndexPin(IndexPin &&other) noexcept
+      : pins_(std::exchange(other.pins_, nullptr)) {}
+  IndexPin(const IndexPin &) = delete;
+  IndexPin &operator=(const IndexPin &) = delete;
+  IndexPin &operator=(IndexPin &&) = delete;
+
+  ~IndexPin() {
+    if (pins_) {
+      pins_->fetch_sub(1, std::memory_order_release);
+    }
+  }
+
+private:
+  std::atomic<std::size_t> *pins_;
+};
+
+// Global cap on the memory held by resident container indexes. A container
+// charges its index size once the index is activated; while the total is over
+// budget the least recently used indexes are asked to unload, and busy ones
+// are skipped rather than waited for.
+class ResidencyBudget {
+public:
+  using Clock = std::chrono::steady_clock;
+  // Unloads the owner's index; false if it is pinned or already gone.
+  using Evictor = std::function<bool()>;
+
+  explicit ResidencyBudget(std::size_t bytes) : budget_(bytes) {}
+
+  ResidencyBudget(const ResidencyBudget &) = delete;
+  ResidencyBudget &operator=(const ResidencyBudget &) = delete;
+
+  // `last_used` must stay valid until release(owner).
+  void charge(const void *owner, std::size_t bytes,
+              const std::atomic<Clock::rep> &last_used, Evictor evict) {
+    std::lock_guard lock(mutex_);
+    auto &entry = entries_[owner];
+    used_ = used_ - entry.bytes + bytes;
+    entry = Entry{bytes, &last_used, std::move(evict)};
+    enforceLocked(owner);
+  }
+
+  // Forgets `owner`. Waits for an eviction pass in progress, so the owner's
+  // evictor is never running once this returns.
+  void release(const void *owner) {
+    std::lock_guard lock(mutex_);
+    if (auto it = entries_.find(owner); it != entries_.end()) {
+      used_ -= it->second.bytes;
+      entries_.erase(it);
+    }
+  }
+
+  std::size_t budget() const { return budget_; }
+
+  std::size_t used() const {
+    std::lock_guard lock(mutex_);
+    return used_;
+  }
+
+  std::size_t residents() const {
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+  }
+
+private:
+  struct Entry {
+    std::size_t bytes = 0;
+    const std::atomic<Clock::rep> *last_used = nullptr;
+    Evictor evict;
+  };
+
+  void enforceLocked(const void *keep) {
+    if (used_ <= budget_) {
+      return;
+    }
+
+    std::vector<std::pair<Clock::rep, const void *>> order;
+    order.reserve(entries_.size());
+    for (const auto &[owner, entry] : entries_) {
+      if (owner != keep) {
+        order.emplace_back(entry.last_used->load(std::memory_order_relaxed),
+                           owner);
+      }
+    }
+    std::sort(order.begin(), order.end());
+
+    for (const auto &[last_used, owner] : order) {
+      if (used_ <= budget_) {
+        return;
+      }
+      auto it = entries_.find(owner);
+      if (it->second.evict()) {
+        used_ -= it->second.bytes;
+        entries_.erase(it);
+      }
+    }
+    if (used_ > budget_) {
+      spdlog::warn("Container indexes hold {} of {} budgeted bytes; the rest "
+                   "are in use",
+                   used_, budget_);
+    }
+  }
+
+  const std::size_t budget_;
+  mutable std::mutex mutex_;
+  std::unordered_map<const void *, Entry> entries_;
+  std::size_t used_ = 0;
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_CONTAINER_RESIDENCY
@@ -3,8 +3,15 @@
 
 #include "vfs/core/loop/loop.hpp"
 #include "vfs/domain.hpp"
+#include <array>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
 #include <typeindex>
 #include <unordered_map>
+#include <vector>
 
 namespace owl {
 
@@ -66,12 +73,6 @@ public:
   ConcreteHandler &get() { return *handler_; }
   const ConcreteHandler &get() const { return *handler_; }
 
-  template <typename Event> void dispatchIfMatch(const Event &event) {
-    if constexpr (std::is_same_v<Event, typename ConcreteHandler::EventType>) {
-      (*handler_)(event);
-    }
-  }
-
 private:
   std::unique_ptr<ConcreteHandler> handler_;
 };
@@ -86,10 +87,41 @@ struct EventTypeExtractor<Handler<Event>> {
 template <typename Handler>
 using EventTypeOf = typename EventTypeExtractor<Handler>::type;
 
+// Position of the one handler for `Event` among `Handlers`, resolved at
+// compile time; sizeof...(Handlers) if there is none.
+template <typename Event, typename... Handlers>
+constexpr std::size_t handlerIndex() {
+  constexpr std::array<bool, sizeof...(Handlers)> matches{
+      std::is_same_v<Event, EventTypeOf<Handlers>>...};
+  for (std::size_t i = 0; i < matches.size(); ++i) {
+    if (matches[i]) {
+      return i;
+    }
+  }
+  return sizeof...(Handlers);
+}
+
+template <typename Event, typename... Handlers>
+constexpr std::size_t handlerCount() {
+  return (std::size_t{std::is_same_v<Event, EventTypeOf<Handlers>>} + ... +
+          0);
+}
+
+// Each event goes straight to its handler. Events that name a container run
+// on that container's strand, so one container's events are handled one at a
+// time and in order while different containers proceed in parallel; the rest
+// run on the loop directly. Containers share kStrands strands by hash.
+//
+// Events for a container that is still loading are held on its strand, and
+// so is every later event for it, until ContainerLoader::gate() lets the
+// oldest through; a timer on the same strand then runs them in arrival order.
 template <typename... ConcreteHandlers> class EventHandlers final {
 public:
+  static constexpr std::size_t kStrands = 256;
+
   explicit EventHandlers(State &state)
       : state_{state}, loop_{std::make_shared<EventLoop>()},
+        strands_{makeStrands(*loop_)}, held_(kStrands),
         handlers_{std::make_tuple(
             EventHandlerWrapper<ConcreteHandlers>(state, *loop_)...)} {
 
@@ -114,13 +146,21 @@ public:
   }
 
   template <typename Event> void dispatch(const Event &event) {
-    loop_->post([this, event]() {
-      std::apply(
-          [&event](auto &...handlers) {
-            (handlers.template dispatchIfMatch(event), ...);
-          },
-          handlers_);
-    });
+    constexpr auto index = handlerIndex<Event, ConcreteHandlers...>();
+    static_assert(index < sizeof...(ConcreteHandlers),
+                  "no handler for this event type");
+
+    auto task = [this, event]() { std::get<index>(handlers_)(event); };
+    if constexpr (requires { event.container_id; }) {
+      const auto lane = laneFor(event.container_id);
+      boost::asio::post(strands_[lane],
+                        [this, lane, id = event.container_id,
+                         task = std::move(task)]() mutable {
+                          runOrHold(lane, id, std::move(task));
+                        });
+    } else {
+      loop_->post(std::move(task));
+    }
   }
 
   template <typename Event> void postEvent(const Event &event) {
@@ -141,14 +181,88 @@ public:
 private:
   template <typename Handler> void registerDispatcher() {
     using EventType = EventTypeOf<Handler>;
+    static_assert(handlerCount<EventType, ConcreteHandlers...>() == 1,
+                  "each event type needs exactly one handler");
 
     state_.events_.template Subscribe<EventType>(
         [this](const EventType &event) { this->dispatch(event); });
   }
 
+  static std::vector<EventLoop::Strand> makeStrands(EventLoop &loop) {
+    std::vector<EventLoop::Strand> strands;
+    strands.reserve(kStrands);
+    for (std::size_t i = 0; i < kStrands; ++i) {
+      strands.push_back(loop.make_strand());
+    }
+    return strands;
+  }
+
+  std::size_t laneFor(const std::string &container_id) const {
+    return std::hash<std::string>{}(container_id) % strands_.size();
+  }
+
+  struct Held {
+    ContainerLoader::Clock::time_point since;
+    std::function<void()> run;
+  };
+  // Per strand, and only touched on it.
+  using HeldEvents = std::unordered_map<std::string, std::deque<Held>>;
+
+  // On the container's strand.
+  void runOrHold(std::size_t lane, const std::string &id,
+                 std::function<void()> task) {
+    const auto now = ContainerLoader::Clock::now();
+    auto &held = held_[lane];
+    if (auto it = held.find(id); it != held.end()) {
+      it->second.push_back({now, std::move(task)});
+      return;
+    }
+    if (state_.loader_.gate(id, now) != ContainerLoader::Gate::Retry) {
+      task();
+      return;
+    }
+    held[id].push_back({now, std::move(task)});
+    retryLater(lane, id);
+  }
+
+  void retryLater(std::size_t lane, const std::string &id) {
+    auto timer = std::make_shared<boost::asio::steady_timer>(
+        strands_[lane], ContainerLoader::kRetryInterval);
+    timer->async_wait(
+        [this, lane, id, timer](const boost::system::error_code &ec) {
+          if (!ec) {
+            drain(lane, id);
+          }
+        });
+  }
+
+  // Runs held events, oldest first, until one still has to wait. Refused
+  // ones run too: ContainerExists answers them with "loading".
+  void drain(std::size_t lane, const std::string &id) {
+    auto &held = held_[lane];
+    auto it = held.find(id);
+    if (it == held.end()) {
+      return;
+    }
+    auto &queue = it->second;
+    while (!queue.empty()) {
+      if (state_.loader_.gate(id, queue.front().since) ==
+          ContainerLoader::Gate::Retry) {
+        retryLater(lane, id);
+        return;
+      }
+      auto next = std::move(queue.front());
+      queue.pop_front();
+      next.run();
+    }
+    held.erase(it);
+  }
+
 private:
   State &state_;
   std::shared_ptr<EventLoop> loop_;
+  std::vector<EventLoop::Strand> strands_;
+  std::vector<HeldEvents> held_;
   std::tuple<EventHandlerWrapper<ConcreteHandlers>...> handlers_;
 };
 
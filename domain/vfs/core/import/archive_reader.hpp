@@ -0,0 +1,437 @@
+#ifndef OWL_VFS_CORE_IMPORT_ARCHIVE_READER
+#define OWL_VFS_CORE_IMPORT_ARCHIVE_READER
+
+#include <lz4frame.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace owl {
+
+namespace fs = std::filesystem;
+
+// An entry's body is not held: the sink reads `size` bytes from the body
+// source it is handed alongside.
+struct ImportEntry {
+  std::string path;
+  std::uint64_t size = 0;
+};
+
+// Relative, normalised path inside the container, or nullopt for anything
+// that would escape data_path.
+inline std::optional<std::string> sanitizeImportPath(std::string_view raw) {
+  auto path = fs::path(std::string(raw)).lexically_normal().relative_path();
+  auto normalized = path.generic_string();
+
+  while (!normalized.empty() && normalized.back() == '/') {
+    normalized.pop_back();
+  }
+  if (normalized.empty() || normalized == "." || normalized.rfind("..", 0) == 0) {
+    return std::nullopt;
+  }
+  return normalized;
+}
+
+class FileByteSource {
+public:
+  explicit FileByteSource(const fs::path &path)
+      : in_(path, std::ios::binary), remaining_(fs::file_size(path)) {
+    if (!in_) {
+      throw std::runtime_error("cannot open " + path.string());
+    }
+  }
+
+  std::size_t read(char *dst, std::size_t size) {
+    in_.read(dst, static_cast<std::streamsize>(size));
+    const auto n = static_cast<std::size_t>(in_.gcount());
+    remaining_ -= std::min<std::uint64_t>(n, remaining_);
+    return n;
+  }
+
+  // Bytes left before the end of the file.
+  std::uint64_t remaining() const { return remaining_; }
+
+private:
+  std::ifstream in_;
+  std::uint64_t remaining_;
+};
+
+// Streams an LZ4 frame through a fixed-size window, so decompressing a large
+// archive never holds more than one input and one output block in memory.
+class Lz4ByteSource {
+public:
+  static constexpr std::size_t kBlockSize = 1 << 16;
+
+  explicit Lz4ByteSource(const fs::path &path)
+      : file_(path), input_(kBlockSize), output_(kBlockSize * 4) {
+    const auto rc = LZ4F_createDecompressionContext(&ctx_, LZ4F_VERSION);
+    if (LZ4F_isError(rc)) {
+      throw std::runtime_error(std::string("lz4: ") + LZ4F_getErrorName(rc));
+    }
+  }
+
+  ~Lz4ByteSource() { LZ4F_freeDecompressionContext(ctx_); }
+
+  Lz4ByteSource(const Lz4ByteSource &) = delete;
+  Lz4ByteSource &operator=(const Lz4ByteSource &) = delete;
+
+  std::size_t read(char *dst, std::size_t size) {
+    std::size_t copied = 0;
+
+    while (copied < size) {
+      if (out_pos_ < out_len_) {
+        const auto n = std::min(size - copied, out_len_ - out_pos_);
+        std::memcpy(dst + copied, output_.data() + out_pos_, n);
+        out_pos_ += n;
+        copied += n;
+        continue;
+      }
+
+      if (in_pos_ == in_len_) {
+        in_len_ = file_.read(input_.data(), input_.size());
+        in_pos_ = 0;
+        if (in_len_ == 0) {
+          break;
+        }
+      }
+
+      std::size_t dst_size = output_.size();
+      std::size_t src_size = in_len_ - in_pos_;
+      const auto rc = LZ4F_decompress(ctx_, output_.data(), &dst_size,
+                                      input_.data() + in_pos_, &src_size,
+                                      nullptr);
+      if (LZ4F_isError(rc)) {
+        throw std::runtime_error(std::string("lz4: ") + LZ4F_getErrorName(rc));
+      }
+
+      in_pos_ += src_size;
+      out_pos_ = 0;
+      out_len_ = dst_size;
+    }
+
+    return copied;
+  }
+
+private:
+  FileByteSource file_;
+  LZ4F_dctx *ctx_ = nullptr;
+  std::vector<char> input_;
+  std::vector<char> output_;
+  std::size_t in_pos_ = 0;
+  std::size_t in_len_ = 0;
+  std::size_t out_pos_ = 0;
+  std::size_t out_len_ = 0;
+};
+
+// Minimal ustar reader: regular files only, with GNU long names and the pax
+// `path` record honoured. Everything else is skipped. next() only parses the
+// header; the body is then read through read(), and whatever the caller left
+// unread is skipped by the following next(). A header declaring more than
+// `max_entry_bytes`, or more than the source has left, is rejected before
+// anything is read from its body.
+template <typename Source> class TarReader {
+public:
+  static constexpr std::size_t kBlock = 512;
+  // GNU long names and pax records are read whole.
+  static constexpr std::uint64_t kMaxMetadataBytes = 1 << 20;
+
+  TarReader(Source &source, std::uint64_t max_entry_bytes)
+      : source_(source), max_entry_bytes_(max_entry_bytes) {}
+
+  bool next(ImportEntry &entry) {
+    skip(body_left_ + body_padding_);
+    body_left_ = 0;
+    body_padding_ = 0;
+
+    std::string long_name;
+
+    while (true) {
+      std::array<char, kBlock> header{};
+      if (!readExact(header.data(), kBlock)) {
+        return false;
+      }
+      if (std::all_of(header.begin(), header.end(),
+                      [](char c) { return c == 0; })) {
+        return false;
+      }
+      verifyChecksum(header);
+
+      const auto size = parseSize(field(header, 124, 12));
+      const char type = header[156];
+      checkSize(size);
+
+      if (type == 'L' || type == 'x') {
+        if (size > kMaxMetadataBytes) {
+          throw std::runtime_error("tar: oversized extended header");
+        }
+        auto body = readBody(size);
+        if (type == 'L') {
+          long_name = std::string(body.c_str());
+        } else if (auto path = paxPath(body)) {
+          long_name = *path;
+        }
+        continue;
+      }
+
+      if (type != '0' && type != '\0' && type != '7') {
+        skip(padded(size));
+        long_name.clear();
+        continue;
+      }
+
+      if (!long_name.empty()) {
+        entry.path = std::move(long_name);
+      } else {
+        entry.path = std::string(field(header, 0, 100));
+        const auto prefix = field(header, 345, 155);
+        if (std::string_view(header.data() + 257, 5) == "ustar" &&
+            !prefix.empty()) {
+          entry.path = std::string(prefix) + "/" + entry.path;
+        }
+      }
+      if (size > max_entry_bytes_) {
+        throw std::runtime_error("tar: " + entry.path + " is " +
+                                 std::to_string(size) +
+                                 " bytes, over the import limit of " +
+                                 std::to_string(max_entry_bytes_));
+      }
+      entry.size = size;
+      body_left_ = size;
+      body_padding_ = padded(size) - size;
+      return true;
+    }
+  }
+
+  // Up to `size` bytes of the current entry's body; 0 once it is exhausted.
+  std::size_t read(char *dst, std::size_t size) {
+    const auto n =
+        static_cast<std::size_t>(std::min<std::uint64_t>(size, body_left_));
+    if (n > 0 && !readExact(dst, n)) {
+      throw std::runtime_error("tar: unexpected end of archive");
+    }
+    body_left_ -= n;
+    return n;
+  }
+
+private:
+  static std::string_view field(const std::array<char, kBlock> &header,
+                                std::size_t offset, std::size_t length) {
+    std::string_view view(header.data() + offset, length);
+    return view.substr(0, view.find('\0'));
+  }
+
+  static std::uint64_t parseSize(std::string_view text) {
+    if (!text.empty() && (static_cast<unsigned char>(text[0]) & 0x80)) {
+      std::uint64_t value = 0;
+      for (std::size_t i = 1; i < text.size(); ++i) {
+        value = (value << 8) | static_cast<unsigned char>(text[i]);
+      }
+      return value;
+    }
+
+    std::uint64_t value = 0;
+    for (const char c : text) {
+      if (c >= '0' && c <= '7') {
+        value = value * 8 + static_cast<std::uint64_t>(c - '0');
+      }
+    }
+    return value;
+  }
+
+  static std::uint64_t padded(std::uint64_t size) {
+    return (size + kBlock - 1) / kBlock * kBlock;
+  }
+
+  static void verifyChecksum(const std::array<char, kBlock> &header) {
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < kBlock; ++i) {
+      sum += (i >= 148 && i < 156) ? ' ' : static_cast<unsigned char>(header[i]);
+    }
+    if (sum != parseSize(field(header, 148, 8))) {
+      throw std::runtime_error("tar: header checksum mismatch");
+    }
+  }
+
+  static std::optional<std::string> paxPath(const std::string &records) {
+    std::size_t pos = 0;
+    while (pos < records.size()) {
+      const auto space = records.find(' ', pos);
+      if (space == std::string::npos) {
+        break;
+      }
+      const auto length = std::stoull(records.substr(pos, space - pos));
+      if (length == 0 || pos + length > records.size()) {
+        break;
+      }
+
+      const std::string_view record(records.data() + space + 1,
+                                    length - (space + 1 - pos) - 1);
+      if (record.rfind("path=", 0) == 0) {
+        return std::string(record.substr(5));
+      }
+      pos += length;
+    }
+    return std::nullopt;
+  }
+
+  // Catches a corrupt or truncated size field before it is acted on. Sources
+  // that cannot tell what is left, such as an LZ4 stream, are bounded by the
+  // chunked reads instead.
+  void checkSize(std::uint64_t size) {
+    if constexpr (requires { source_.remaining(); }) {
+      if (padded(size) > source_.remaining()) {
+        throw std::runtime_error("tar: entry of " + std::to_string(size) +
+                                 " bytes runs past the end of the archive");
+      }
+    }
+  }
+
+  bool readExact(char *dst, std::size_t size) {
+    std::size_t got = 0;
+    while (got < size) {
+      const auto n = source_.read(dst + got, size - got);
+      if (n == 0) {
+        if (got == 0) {
+          return false;
+        }
+        throw std::runtime_error("tar: unexpected end of archive");
+      }
+      got += n;
+    }
+    return true;
+  }
+
+  std::string readBody(std::uint64_t size) {
+    std::string body(size, '\0');
+    if (size > 0 && !readExact(body.data(), size)) {
+      throw std::runtime_error("tar: unexpected end of archive");
+    }
+    skip(padded(size) - size);
+    return body;
+  }
+
+  void skip(std::uint64_t size) {
+    std::array<char, kBlock> sink{};
+    while (size > 0) {
+      const auto n = static_cast<std::size_t>(std::min<std::uint64_t>(size, kBlock));
+      if (!readExact(sink.data(), n)) {
+        throw std::runtime_error("tar: unexpected end of archive");
+      }
+      size -= n;
+    }
+  }
+
+  Source &source_;
+  std::uint64_t max_entry_bytes_;
+  std::uint64_t body_left_ = 0;
+  std::uint64_t body_padding_ = 0;
+};
+
+enum class ImportSourceKind { Directory, Tar, TarLz4 };
+
+// `source` (relative ones are taken from `root`) with symlinks and ".."
+// resolved, or nullopt unless it exists and is `root` or lies under it.
+inline std::optional<fs::path> resolveImportSource(const fs::path &root,
+                                                   const fs::path &source) {
+  std::error_code ec;
+  const auto base = fs::canonical(root, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  const auto resolved =
+      fs::canonical(source.is_relative() ? base / source : source, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+
+  const auto [left, right] = std::mismatch(base.begin(), base.end(),
+                                           resolved.begin(), resolved.end());
+  if (left != base.end()) {
+    return std::nullopt;
+  }
+  return resolved;
+}
+
+inline std::optional<ImportSourceKind> importSourceKind(const fs::path &source) {
+  if (fs::is_directory(source)) {
+    return ImportSourceKind::Directory;
+  }
+
+  const auto name = source.filename().string();
+  const auto endsWith = [&](std::string_view suffix) {
+    return name.size() >= suffix.size() &&
+           name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+  };
+
+  if (endsWith(".tar.lz4") || endsWith(".tlz4")) {
+    return ImportSourceKind::TarLz4;
+  }
+  if (endsWith(".tar")) {
+    return ImportSourceKind::Tar;
+  }
+  return std::nullopt;
+}
+
+// Feeds every regular file under `source` to `sink(entry, body)` one at a
+// time, where `body` has read(dst, n) like the sources above and must be
+// consumed before the sink returns. Archive entries over `max_entry_bytes`
+// are rejected. Throws on unreadable or malformed input.
+template <typename Sink>
+void forEachImportEntry(const fs::path &source, std::uint64_t max_entry_bytes,
+                        Sink &&sink) {
+  const auto kind = importSourceKind(source);
+  if (!kind) {
+    throw std::runtime_error("unsupported import source: " + source.string());
+  }
+
+  const auto emitTar = [&](auto &bytes) {
+    TarReader reader(bytes, max_entry_bytes);
+    ImportEntry entry;
+    while (reader.next(entry)) {
+      if (auto path = sanitizeImportPath(entry.path)) {
+        entry.path = std::move(*path);
+        sink(std::move(entry), reader);
+      }
+      entry = ImportEntry{};
+    }
+  };
+
+  switch (*kind) {
+  case ImportSourceKind::Directory:
+    for (const auto &item : fs::recursive_directory_iterator(source)) {
+      // Symlinks could point anywhere outside the import root.
+      if (item.is_symlink() || !item.is_regular_file()) {
+        continue;
+      }
+
+      FileByteSource body(item.path());
+      ImportEntry entry{fs::relative(item.path(), source).generic_string(),
+                        body.remaining()};
+      sink(std::move(entry), body);
+    }
+    break;
+  case ImportSourceKind::Tar: {
+    FileByteSource bytes(source);
+    emitTar(bytes);
+    break;
+  }
+  case ImportSourceKind::TarLz4: {
+    Lz4ByteSource bytes(source);
+    emitTar(bytes);
+    break;
+  }
+  }
+}
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_IMPORT_ARCHIVE_READER
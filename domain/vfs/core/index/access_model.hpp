@@ -0,0 +1,319 @@
+#ifndef OWL_VFS_CORE_INDEX_ACCESS_MODEL
+#define OWL_VFS_CORE_INDEX_ACCESS_MODEL
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <infrastructure/result.hpp>
+
+namespace owl {
+
+struct AccessEvent {
+  std::string path;
+  std::string operation;
+  std::chrono::steady_clock::time_point at;
+};
+
+// First-order transition model over file accesses, trained online. Every
+// weight decays exponentially with `half_life` (applied lazily, from the time
+// it was last touched), so old habits fade without a sweep. Memory is
+// bounded: at most `max_files` files and `max_successors` successors each,
+// the weakest evicted first. Only reads, writes and recommendation requests
+// move the "current file"; search hits just add popularity.
+class AccessModel {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Scored = std::vector<std::pair<std::string, float>>;
+  using Error = std::runtime_error;
+
+  static constexpr const char *kFile = "access_model.tsv";
+
+  struct Options {
+    Clock::duration half_life = std::chrono::hours(1);
+    Clock::duration session_gap = std::chrono::minutes(10);
+    std::size_t max_files = 8192;
+    std::size_t max_successors = 32;
+  };
+
+  AccessModel() = default;
+  explicit AccessModel(Options options) : options_(options) {}
+
+  static bool navigates(std::string_view operation) {
+    return operation == "read" || operation == "write" ||
+           operation == "recommendation_request";
+  }
+
+  // Returns the file whose successors changed, if any.
+  std::optional<std::string> observe(const AccessEvent &event) {
+    std::unique_lock lock(mutex_);
+    std::optional<std::string> changed;
+    auto &node = files_[event.path];
+    bump(node.weight, node.touched, event.at);
+
+    if (navigates(event.operation)) {
+      if (last_ && *last_ != event.path &&
+          event.at - last_at_ <= options_.session_gap) {
+        if (auto it = files_.find(*last_); it != files_.end()) {
+          auto &edge = it->second.successors[event.path];
+          bump(edge.weight, edge.touched, event.at);
+          changed = *last_;
+          if (it->second.successors.size() > options_.max_successors) {
+            pruneSuccessors(it->second, event.at);
+          }
+        }
+      }
+      last_ = event.path;
+      last_at_ = event.at;
+    }
+
+    if (files_.size() > options_.max_files) {
+      evict(event.at);
+    }
+    version_.fetch_add(1, std::memory_order_acq_rel);
+    return changed;
+  }
+
+  void forget(const std::string &path) {
+    std::unique_lock lock(mutex_);
+    files_.erase(path);
+    if (last_ == path) {
+      last_.reset();
+    }
+    version_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  // Most likely next files after `path`, by decayed transition weight.
+  Scored successors(const std::string &path, std::size_t k,
+                    Clock::time_point now = Clock::now()) const {
+    std::shared_lock lock(mutex_);
+    auto it = files_.find(path);
+    if (it == files_.end()) {
+      return {};
+    }
+
+    Scored out;
+    double total = 0;
+    for (const auto &[next, edge] : it->second.successors) {
+      if (!files_.count(next)) {
+        continue;
+      }
+      const auto weight = decayed(edge.weight, edge.touched, now);
+      total += weight;
+      out.emplace_back(next, static_cast<float>(weight));
+    }
+    for (auto &[next, weight] : out) {
+      weight = static_cast<float>(weight / total);
+    }
+    return top(std::move(out), k);
+  }
+
+  // Successors of the file accessed last.
+  Scored predict(std::size_t k) const {
+    std::optional<std::string> last;
+    {
+      std::shared_lock lock(mutex_);
+      last = last_;
+    }
+    return last ? successors(*last, k) : Scored{};
+  }
+
+  std::size_t size() const {
+    std::shared_lock lock(mutex_);
+    return files_.size();
+  }
+
+  void clear() {
+    std::unique_lock lock(mutex_);
+    files_ = {};
+    last_.reset();
+    version_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  // Weights are written with their age rather than their steady_clock time,
+  // so they keep decaying from where they were when loaded after a restart.
+  // "F<TAB>weight<TAB>age<TAB>path" per file, each followed by its
+  // "S<TAB>weight<TAB>age<TAB>path" successors.
+  core::Result<void> save(const std::filesystem::path &dir,
+                          Clock::time_point now = Clock::now()) const {
+    try {
+      std::filesystem::create_directories(dir);
+      const auto tmp = dir / (std::string(kFile) + ".tmp");
+
+      std::ofstream out(tmp, std::ios::trunc);
+      {
+        std::shared_lock lock(mutex_);
+        const auto age = [&](Clock::time_point touched) {
+          return std::chrono::duration<double>(now - touched).count();
+        };
+        for (const auto &[path, node] : files_) {
+          out << "F\t" << node.weight << '\t' << age(node.touched) << '\t'
+              << path << '\n';
+          for (const auto &[next, edge] : node.successors) {
+            out << "S\t" << edge.weight << '\t' << age(edge.touched) << '\t'
+                << next << '\n';
+          }
+        }
+      }
+      out.close();
+      if (!out) {
+        return core::Result<void, Error>::Error(
+            Error("failed to write " + tmp.string()));
+      }
+
+      std::filesystem::rename(tmp, dir / kFile);
+      return core::Result<void, Error>::Ok();
+    } catch (const std::exception &e) {
+      return core::Result<void, Error>::Error(
+          Error(std::string("access model save failed: ") + e.what()));
+    }
+  }
+
+  // Replaces the model with what save() wrote; a missing file leaves it empty.
+  core::Result<void> load(const std::filesystem::path &dir,
+                          Clock::time_point now = Clock::now()) {
+    std::ifstream in(dir / kFile);
+    std::unordered_map<std::string, Node> files;
+    Node *current = nullptr;
+
+    std::string line;
+    while (in && std::getline(in, line)) {
+      const auto first = line.find('\t');
+      const auto second = line.find('\t', first + 1);
+      const auto third = line.find('\t', second + 1);
+      if (first != 1 || second == std::string::npos ||
+          third == std::string::npos) {
+        continue;
+      }
+
+      double weight = 0;
+      double age = 0;
+      try {
+        weight = std::stod(line.substr(first + 1, second - first - 1));
+        age = std::stod(line.substr(second + 1, third - second - 1));
+      } catch (const std::exception &) {
+        continue;
+      }
+      const auto touched =
+          now - std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(std::max(age, 0.0)));
+      auto path = line.substr(third + 1);
+
+      if (line[0] == 'F') {
+        current = &files[std::move(path)];
+        current->weight = weight;
+        current->touched = touched;
+      } else if (line[0] == 'S' && current) {
+        current->successors[std::move(path)] = Edge{weight, touched};
+      }
+    }
+
+    std::unique_lock lock(mutex_);
+    files_ = std::move(files);
+    last_.reset();
+    version_.fetch_add(1, std::memory_order_acq_rel);
+    return core::Result<void, Error>::Ok();
+  }
+
+  std::uint64_t version() const {
+    return version_.load(std::memory_order_acquire);
+  }
+
+private:
+  struct Edge {
+    double weight = 0;
+    Clock::time_point touched;
+  };
+
+  struct Node {
+    double weight = 0;
+    Clock::time_point touched;
+    std::unordered_map<std::string, Edge> successors;
+  };
+
+  double decayed(double weight, Clock::time_point touched,
+                 Clock::time_point now) const {
+    const auto age = std::chrono::duration<double>(now - touched).count();
+    const auto half_life =
+        std::chrono::duration<double>(options_.half_life).count();
+    return age <= 0 ? weight : weight * std::exp2(-age / half_life);
+  }
+
+  void bump(double &weight, Clock::time_point &touched, Clock::time_point now) {
+    weight = decayed(weight, touched, now) + 1.0;
+    touched = std::max(touched, now);
+  }
+
+  static Scored top(Scored scored, std::size_t k) {
+    const auto n = std::min(k, scored.size());
+    std::partial_sort(
+        scored.begin(), scored.begin() + static_cast<std::ptrdiff_t>(n),
+        scored.end(),
+        [](const auto &a, const auto &b) { return a.second > b.second; });
+    scored.resize(n);
+    return scored;
+  }
+
+  void pruneSuccessors(Node &node, Clock::time_point now) {
+    auto weakest = node.successors.begin();
+    double lowest =
+        decayed(weakest->second.weight, weakest->second.touched, now);
+    for (auto it = std::next(node.successors.begin());
+         it != node.successors.end(); ++it) {
+      const auto weight = decayed(it->second.weight, it->second.touched, now);
+      if (weight < lowest) {
+        lowest = weight;
+        weakest = it;
+      }
+    }
+    node.successors.erase(weakest);
+  }
+
+  // Drops the weakest eighth at once, so the O(n) selection is amortised over
+  // max_files / 8 insertions.
+  void evict(Clock::time_point now) {
+    std::vector<std::pair<double, const std::string *>> weights;
+    weights.reserve(files_.size());
+    for (const auto &[path, node] : files_) {
+      weights.emplace_back(decayed(node.weight, node.touched, now), &path);
+    }
+    const auto drop = files_.size() - options_.max_files * 7 / 8;
+    std::nth_element(weights.begin(),
+                     weights.begin() + static_cast<std::ptrdiff_t>(drop),
+                     weights.end());
+
+    std::vector<std::string> victims;
+    victims.reserve(drop);
+    for (std::size_t i = 0; i < drop; ++i) {
+      if (*weights[i].second != last_) {
+        victims.push_back(*weights[i].second);
+      }
+    }
+    for (const auto &path : victims) {
+      files_.erase(path);
+    }
+  }
+
+  Options options_;
+  mutable std::shared_mutex mutex_;
+  std::unordered_map<std::string, Node> files_;
+  std::optional<std::string> last_;
+  Clock::time_point last_at_;
+  std::atomic<std::uint64_t> version_{0};
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_ACCESS_MODEL
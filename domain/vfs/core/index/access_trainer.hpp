@@ -0,0 +1,116 @@
+#ifndef OWL_VFS_CORE_INDEX_ACCESS_TRAINER
+#define OWL_VFS_CORE_INDEX_ACCESS_TRAINER
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "vfs/core/index/access_model.hpp"
+#include "vfs/core/loop/mpsc_ring.hpp"
+
+namespace owl {
+
+// Moves access bookkeeping off the request path: record() is one lock-free
+// ring push, and a trainer thread hands the events to `sink` in batches.
+// When the trainer falls behind by a whole ring, new events are dropped and
+// counted instead of making callers wait. After each drain the thread runs
+// `idle`, which poke() can also request without an event.
+class AccessTrainer {
+public:
+  using Sink = std::function<void(const std::vector<AccessEvent> &)>;
+  using Idle = std::function<void()>;
+
+  static constexpr std::size_t kCapacity = 16384;
+  static constexpr std::size_t kBatch = 256;
+
+  explicit AccessTrainer(Sink sink, Idle idle = {})
+      : sink_(std::move(sink)), idle_(std::move(idle)),
+        thread_([this] { run(); }) {}
+
+  ~AccessTrainer() {
+    stop_.store(true, std::memory_order_release);
+    wake();
+    thread_.join();
+  }
+
+  AccessTrainer(const AccessTrainer &) = delete;
+  AccessTrainer &operator=(const AccessTrainer &) = delete;
+
+  bool record(std::string path, std::string operation) {
+    if (!ring_.tryPush(AccessEvent{std::move(path), std::move(operation),
+                                   AccessModel::Clock::now()})) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    wake();
+    return true;
+  }
+
+  void poke() { wake(); }
+
+  std::uint64_t applied() const {
+    return applied_.load(std::memory_order_acquire);
+  }
+  std::uint64_t dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+private:
+  // The exchange is a full barrier on both sides: either the trainer's
+  // exchange(false) sees this push, or the trainer is woken again.
+  void wake() {
+    if (!pending_.exchange(true, std::memory_order_acq_rel)) {
+      pending_.notify_one();
+    }
+  }
+
+  void run() {
+    std::vector<AccessEvent> batch;
+    batch.reserve(kBatch);
+    for (;;) {
+      pending_.wait(false, std::memory_order_acquire);
+      pending_.exchange(false, std::memory_order_acq_rel);
+
+      while (auto event = ring_.tryPop()) {
+        batch.push_back(std::move(*event));
+        if (batch.size() == kBatch) {
+          apply(batch);
+        }
+      }
+      apply(batch);
+
+      if (stop_.load(std::memory_order_acquire)) {
+        return;
+      }
+      if (idle_) {
+        idle_();
+      }
+    }
+  }
+
+  void apply(std::vector<AccessEvent> &batch) {
+    if (batch.empty()) {
+      return;
+    }
+    sink_(batch);
+    applied_.fetch_add(batch.size(), std::memory_order_release);
+    batch.clear();
+  }
+
+  Sink sink_;
+  Idle idle_;
+  MpscRing<AccessEvent> ring_{kCapacity};
+  std::atomic<bool> pending_{false};
+  std::atomic<bool> stop_{false};
+  std::atomic<std::uint64_t> applied_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::thread thread_;
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_ACCESS_TRAINER
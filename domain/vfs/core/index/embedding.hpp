@@ -0,0 +1,42 @@
+#ifndef OWL_VFS_CORE_INDEX_EMBEDDING
+#define OWL_VFS_CORE_INDEX_EMBEDDING
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <infrastructure/result.hpp>
+
+namespace owl {
+
+// Single place where owl asks an embedder for a dense vector, so the owl-side
+// indexes do not depend on which flavour of embed() a given embedder exposes.
+template <typename EmbedderT>
+core::Result<std::vector<float>> embedText(EmbedderT &embedder,
+                                           const std::string &text) {
+  using Error = std::runtime_error;
+
+  try {
+    auto embedded = embedder.embed(text);
+
+    if constexpr (requires { embedded.is_ok(); }) {
+      if (!embedded.is_ok()) {
+        return core::Result<std::vector<float>, Error>::Error(
+            Error("embed failed: " + std::string(embedded.error().what())));
+      }
+      const auto &values = embedded.value();
+      return core::Result<std::vector<float>, Error>::Ok(
+          std::vector<float>(values.begin(), values.end()));
+    } else {
+      return core::Result<std::vector<float>, Error>::Ok(
+          std::vector<float>(embedded.begin(), embedded.end()));
+    }
+  } catch (const std::exception &e) {
+    return core::Result<std::vector<float>, Error>::Error(
+        Error(std::string("embed failed: ") + e.what()));
+  }
+}
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_EMBEDDING
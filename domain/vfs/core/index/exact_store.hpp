@@ -0,0 +1,256 @@
+#ifndef OWL_VFS_CORE_INDEX_EXACT_STORE
+#define OWL_VFS_CORE_INDEX_EXACT_STORE
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <infrastructure/result.hpp>
+#include <spdlog/spdlog.h>
+
+namespace owl {
+
+namespace fs = std::filesystem;
+
+// Full-precision copies of the vectors behind a quantised index, kept on disk
+// rather than in the heap: rows are appended to `vectors.f32` and read back
+// with pread() only for the handful of candidates being re-ranked, so they
+// live in the page cache where the kernel can reclaim them. A re-upserted path
+// gets a new row; the old one is dropped the next time flush() compacts.
+class ExactVectorStore {
+public:
+  using Error = std::runtime_error;
+
+  static constexpr const char *kDataFile = "vectors.f32";
+  static constexpr const char *kRowsFile = "vectors.f32.rows";
+
+  ~ExactVectorStore() {
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+
+  ExactVectorStore(const ExactVectorStore &) = delete;
+  ExactVectorStore &operator=(const ExactVectorStore &) = delete;
+
+  static core::Result<std::shared_ptr<ExactVectorStore>>
+  open(const fs::path &dir) {
+    using Ptr = std::shared_ptr<ExactVectorStore>;
+    try {
+      fs::create_directories(dir);
+      auto store = Ptr(new ExactVectorStore(dir));
+
+      std::ifstream in(dir / kRowsFile);
+      if (in && fs::exists(dir / kDataFile)) {
+        in >> store->dimension_ >> store->next_row_;
+        std::string line;
+        std::getline(in, line);
+        while (std::getline(in, line)) {
+          const auto tab = line.find('\t');
+          if (tab == std::string::npos) {
+            continue;
+          }
+          store->rows_.emplace(line.substr(tab + 1),
+                               std::stoull(line.substr(0, tab)));
+        }
+      } else {
+        std::error_code ec;
+        fs::remove(dir / kDataFile, ec);
+      }
+
+      // A row table that points past the end of the data file is left over
+      // from a compaction interrupted between the two renames.
+      struct stat st {};
+      const bool exists = ::stat((dir / kDataFile).c_str(), &st) == 0;
+      if (exists && static_cast<std::uint64_t>(st.st_size) <
+                        store->next_row_ * store->dimension_ * sizeof(float)) {
+        spdlog::warn("Discarding inconsistent exact vectors in {}",
+                     dir.string());
+        store->rows_.clear();
+        store->next_row_ = 0;
+        store->dimension_ = 0;
+        fs::remove(dir / kDataFile);
+      } else if (exists && st.st_nlink > 1) {
+        // Clones made before copies replaced hardlinks may still share this
+        // file; appending in place would leak rows into the sibling container.
+        const auto tmp = dir / (std::string(kDataFile) + ".tmp");
+        fs::copy_file(dir / kDataFile, tmp,
+                      fs::copy_options::overwrite_existing);
+        fs::rename(tmp, dir / kDataFile);
+      }
+
+      store->fd_ = ::open((dir / kDataFile).c_str(),
+                          O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+      if (store->fd_ < 0) {
+        return core::Result<Ptr, Error>::Error(
+            Error("cannot open " + (dir / kDataFile).string()));
+      }
+      return core::Result<Ptr, Error>::Ok(std::move(store));
+    } catch (const std::exception &e) {
+      return core::Result<Ptr, Error>::Error(
+          Error(std::string("exact vector store open failed: ") + e.what()));
+    }
+  }
+
+  std::size_t dimension() const {
+    std::shared_lock lock(mutex_);
+    return dimension_;
+  }
+
+  std::size_t size() const {
+    std::shared_lock lock(mutex_);
+    return rows_.size();
+  }
+
+  bool contains(const std::string &path) const {
+    std::shared_lock lock(mutex_);
+    return rows_.find(path) != rows_.end();
+  }
+
+  core::Result<void> put(const std::string &path, const float *vector,
+                         std::size_t dimension) {
+    std::unique_lock lock(mutex_);
+    if (dimension_ == 0) {
+      dimension_ = dimension;
+    }
+    if (dimension != dimension_) {
+      return core::Result<void, Error>::Error(
+          Error("exact vector dimension mismatch for " + path));
+    }
+
+    const auto row = next_row_;
+    if (!writeRow(fd_, row, vector)) {
+      return core::Result<void, Error>::Error(
+          Error("failed to append exact vector for " + path));
+    }
+    ++next_row_;
+    rows_[path] = row;
+    return core::Result<void, Error>::Ok();
+  }
+
+  void erase(const std::string &path) {
+    std::unique_lock lock(mutex_);
+    rows_.erase(path);
+  }
+
+  bool read(const std::string &path, float *out) const {
+    std::shared_lock lock(mutex_);
+    auto it = rows_.find(path);
+    if (it == rows_.end()) {
+      return false;
+    }
+    const auto bytes = dimension_ * sizeof(float);
+    return ::pread(fd_, out, bytes, static_cast<off_t>(it->second * bytes)) ==
+           static_cast<ssize_t>(bytes);
+  }
+
+  // Visits every live (path, vector) pair, in file order.
+  template <typename Visitor> void forEach(Visitor &&visit) const {
+    std::shared_lock lock(mutex_);
+    std::vector<std::pair<std::uint64_t, const std::string *>> order;
+    order.reserve(rows_.size());
+    for (const auto &[path, row] : rows_) {
+      order.emplace_back(row, &path);
+    }
+    std::sort(order.begin(), order.end());
+
+    const auto bytes = dimension_ * sizeof(float);
+    std::vector<float> buffer(dimension_);
+    for (const auto &[row, path] : order) {
+      if (::pread(fd_, buffer.data(), bytes, static_cast<off_t>(row * bytes)) ==
+          static_cast<ssize_t>(bytes)) {
+        visit(*path, buffer);
+      }
+    }
+  }
+
+  // Persists the row table, first rewriting the data file when more than half
+  // of it is dead rows.
+  core::Result<void> flush() {
+    std::unique_lock lock(mutex_);
+    try {
+      if (next_row_ > 2 * rows_.size() + 1024) {
+        compactLocked();
+      }
+
+      const auto tmp = dir_ / (std::string(kRowsFile) + ".tmp");
+      std::ofstream out(tmp, std::ios::trunc);
+      out << dimension_ << '\t' << next_row_ << '\n';
+      for (const auto &[path, row] : rows_) {
+        out << row << '\t' << path << '\n';
+      }
+      out.close();
+      if (!out || ::fdatasync(fd_) != 0) {
+        return core::Result<void, Error>::Error(
+            Error("failed to write " + tmp.string()));
+      }
+      fs::rename(tmp, dir_ / kRowsFile);
+      return core::Result<void, Error>::Ok();
+    } catch (const std::exception &e) {
+      return core::Result<void, Error>::Error(
+          Error(std::string("exact vector store flush failed: ") + e.what()));
+    }
+  }
+
+private:
+  explicit ExactVectorStore(fs::path dir) : dir_(std::move(dir)) {}
+
+  bool writeRow(int fd, std::uint64_t row, const float *vector) const {
+    const auto bytes = dimension_ * sizeof(float);
+    return ::pwrite(fd, vector, bytes, static_cast<off_t>(row * bytes)) ==
+           static_cast<ssize_t>(bytes);
+  }
+
+  void compactLocked() {
+    const auto tmp = dir_ / (std::string(kDataFile) + ".tmp");
+    const int fd =
+        ::open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+      throw Error("cannot create " + tmp.string());
+    }
+
+    std::vector<float> buffer(dimension_);
+    const auto bytes = dimension_ * sizeof(float);
+    std::unordered_map<std::string, std::uint64_t> rows;
+    rows.reserve(rows_.size());
+    std::uint64_t next = 0;
+    for (const auto &[path, row] : rows_) {
+      if (::pread(fd_, buffer.data(), bytes, static_cast<off_t>(row * bytes)) !=
+              static_cast<ssize_t>(bytes) ||
+          !writeRow(fd, next, buffer.data())) {
+        ::close(fd);
+        throw Error("failed to compact " + (dir_ / kDataFile).string());
+      }
+      rows.emplace(path, next++);
+    }
+
+    fs::rename(tmp, dir_ / kDataFile);
+    ::close(fd_);
+    fd_ = fd;
+    rows_ = std::move(rows);
+    next_row_ = next;
+  }
+
+  fs::path dir_;
+  mutable std::shared_mutex mutex_;
+  int fd_ = -1;
+  std::size_t dimension_ = 0;
+  std::uint64_t next_row_ = 0;
+  std::unordered_map<std::string, std::uint64_t> rows_;
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_EXACT_STORE
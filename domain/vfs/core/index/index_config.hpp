@@ -0,0 +1,159 @@
+#ifndef OWL_VFS_CORE_INDEX_INDEX_CONFIG
+#define OWL_VFS_CORE_INDEX_INDEX_CONFIG
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace owl {
+
+namespace fs = std::filesystem;
+
+// Per-query recall/latency knobs; 0 keeps the container's default.
+struct VectorSearchParams {
+  int nprobe = 0;
+  int ef_search = 0;
+
+  bool operator==(const VectorSearchParams &) const = default;
+};
+
+// Ordered by how far they scale; automatic migration only moves forward.
+enum class IndexFamily { Flat, Hnsw, Ivf };
+
+// True when the factory keeps full float32 vectors (no quantisation).
+inline bool exactFactory(std::string_view factory) {
+  return factory == "Flat" ||
+         (factory.starts_with("HNSW") &&
+          factory.find_first_of("_,") == std::string_view::npos);
+}
+
+inline IndexFamily indexFamily(std::string_view factory) {
+  if (factory.starts_with("IVF")) {
+    return IndexFamily::Ivf;
+  }
+  if (factory.starts_with("HNSW")) {
+    return IndexFamily::Hnsw;
+  }
+  return IndexFamily::Flat;
+}
+
+// The "vector_index" section of container_config.json:
+//
+//   "vector_index": {"type": "auto" | "Flat" | "HNSW32" | "IVF4096,PQ60",
+//                    "storage": "float32" | "fp16" | "int8",
+//                    "nprobe": 16, "ef_search": 64}
+//
+// `type` is a faiss index factory string. "auto" (also used when the section
+// is missing) picks one from the corpus size, and `storage` then selects the
+// scalar quantizer for the Flat and HNSW sizes. Explicit types are used as
+// given.
+struct IndexConfig {
+  static constexpr const char *kAuto = "auto";
+  static constexpr std::size_t kHnswThreshold = 20'000;
+  static constexpr std::size_t kIvfThreshold = 500'000;
+
+  // Compressed indexes return this many times more candidates than asked
+  // for, which are then re-scored against the exact float vectors.
+  static constexpr std::size_t kRerankFactor = 4;
+
+  std::string type = kAuto;
+  std::string storage = "float32";
+  int nprobe = 16;
+  int ef_search = 64;
+
+  bool automatic() const { return type == kAuto; }
+
+  // faiss scalar quantizer suffix for `storage`, empty for float32.
+  std::string quantizer() const {
+    if (storage == "int8") {
+      return "SQ8";
+    }
+    if (storage == "fp16") {
+      return "SQfp16";
+    }
+    return {};
+  }
+
+  VectorSearchParams defaults() const { return {nprobe, ef_search}; }
+
+  std::string factoryFor(std::size_t count, std::size_t dimension) const {
+    if (!automatic()) {
+      return type;
+    }
+    const auto sq = quantizer();
+    if (count < kHnswThreshold) {
+      return sq.empty() ? "Flat" : sq;
+    }
+    if (count < kIvfThreshold) {
+      return sq.empty() ? "HNSW32" : "HNSW32_" + sq;
+    }
+
+    const auto nlist = std::clamp<std::size_t>(
+        static_cast<std::size_t>(4 * std::sqrt(static_cast<double>(count))),
+        1024, 65536);
+
+    // PQ needs a sub-quantizer count that divides the dimension.
+    std::size_t m = std::min<std::size_t>(64, std::max<std::size_t>(1, dimension / 4));
+    while (m > 1 && dimension % m != 0) {
+      --m;
+    }
+    return "IVF" + std::to_string(nlist) + ",PQ" + std::to_string(m);
+  }
+
+  // faiss wants roughly 39 training points per IVF list and 256 per PQ
+  // codebook; below that an IVF index is not worth building.
+  static std::size_t minTrainingSize(std::string_view factory) {
+    if (indexFamily(factory) != IndexFamily::Ivf) {
+      return 0;
+    }
+    const auto nlist = std::strtoull(std::string(factory.substr(3)).c_str(),
+                                     nullptr, 10);
+    return std::max<std::size_t>(39 * nlist, 256);
+  }
+
+  static IndexConfig fromJson(const nlohmann::json &config) {
+    IndexConfig out;
+    if (!config.is_object() || !config.contains("vector_index")) {
+      return out;
+    }
+
+    const auto &section = config["vector_index"];
+    if (section.is_string()) {
+      out.type = section.get<std::string>();
+      return out;
+    }
+    if (section.is_object()) {
+      out.type = section.value("type", out.type);
+      out.storage = section.value("storage", out.storage);
+      out.nprobe = section.value("nprobe", out.nprobe);
+      out.ef_search = section.value("ef_search", out.ef_search);
+    }
+    return out;
+  }
+
+  static IndexConfig load(const fs::path &config_path) {
+    try {
+      std::ifstream in(config_path);
+      if (!in) {
+        return {};
+      }
+      nlohmann::json config;
+      in >> config;
+      return fromJson(config);
+    } catch (const std::exception &e) {
+      spdlog::warn("Ignoring vector_index in {}: {}", config_path.string(),
+                   e.what());
+      return {};
+    }
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_INDEX_CONFIG
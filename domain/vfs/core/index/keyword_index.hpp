@@ -0,0 +1,378 @@
+#ifndef OWL_VFS_CORE_INDEX_KEYWORD_INDEX
+#define OWL_VFS_CORE_INDEX_KEYWORD_INDEX
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace owl {
+
+// Splits text into lowercase identifier tokens. Whole identifiers are kept so
+// that `getUserId` or `E_CONN_REFUSED` match verbatim, and their snake_case /
+// camelCase parts are emitted as well.
+class KeywordTokenizer {
+public:
+  static constexpr std::size_t kMaxTokenLength = 64;
+
+  template <typename Sink> static void tokenize(std::string_view text, Sink &&sink) {
+    std::size_t i = 0;
+    while (i < text.size()) {
+      while (i < text.size() && !isWordChar(text[i])) {
+        ++i;
+      }
+
+      const std::size_t start = i;
+      while (i < text.size() && isWordChar(text[i])) {
+        ++i;
+      }
+
+      if (i > start) {
+        emitIdentifier(text.substr(start, i - start), sink);
+      }
+    }
+  }
+
+  static std::vector<std::string> tokenize(std::string_view text) {
+    std::vector<std::string> tokens;
+    tokenize(text, [&](std::string token) { tokens.push_back(std::move(token)); });
+    return tokens;
+  }
+
+private:
+  static bool isWordChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+  }
+
+  static std::string lower(std::string_view word) {
+    std::string out(word.substr(0, kMaxTokenLength));
+    for (auto &c : out) {
+      c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return out;
+  }
+
+  template <typename Sink>
+  static void emitIdentifier(std::string_view word, Sink &sink) {
+    if (word.size() < 2) {
+      return;
+    }
+
+    sink(lower(word));
+
+    std::size_t part_start = 0;
+    std::size_t parts = 0;
+    std::vector<std::string_view> pieces;
+
+    for (std::size_t j = 1; j <= word.size(); ++j) {
+      const bool at_end = j == word.size();
+      const bool boundary =
+          at_end || word[j] == '_' ||
+          (std::isupper(static_cast<unsigned char>(word[j])) &&
+           std::islower(static_cast<unsigned char>(word[j - 1])));
+
+      if (!boundary) {
+        continue;
+      }
+
+      if (j > part_start && word[part_start] != '_') {
+        pieces.push_back(word.substr(part_start, j - part_start));
+        ++parts;
+      }
+      part_start = (!at_end && word[j] == '_') ? j + 1 : j;
+    }
+
+    if (parts > 1) {
+      for (const auto piece : pieces) {
+        if (piece.size() >= 2) {
+          sink(lower(piece));
+        }
+      }
+    }
+  }
+};
+
+// Per-container inverted index scored with BM25. Posting lists are stored as
+// varint-encoded (doc gap, term frequency) pairs; document ids only grow, so
+// new postings are always appended. Removed documents are tombstoned and the
+// lists are compacted once enough of them pile up.
+class KeywordIndex {
+public:
+  using DocId = std::uint32_t;
+  using Hits = std::vector<std::pair<std::string, float>>;
+
+  static constexpr float kK1 = 1.2f;
+  static constexpr float kB = 0.75f;
+  static constexpr double kCompactRatio = 0.25;
+
+  KeywordIndex() = default;
+
+  KeywordIndex(const KeywordIndex &) = delete;
+  KeywordIndex &operator=(const KeywordIndex &) = delete;
+
+  // Term counts for one document, collected a piece at a time so that text
+  // streamed off disk never has to be held whole.
+  class Terms {
+  public:
+    void add(std::string_view text) {
+      KeywordTokenizer::tokenize(text, [&](std::string token) {
+        ++frequencies_[std::move(token)];
+        ++length_;
+      });
+    }
+
+  private:
+    friend class KeywordIndex;
+    std::unordered_map<std::string, std::uint32_t> frequencies_;
+    std::uint32_t length_ = 0;
+  };
+
+  void add(const std::string &path, std::string_view content) {
+    Terms terms;
+    terms.add(content);
+    add(path, terms);
+  }
+
+  void add(const std::string &path, const Terms &terms) {
+    std::unique_lock lock(mutex_);
+    removeUnsafe(path);
+
+    const auto id = static_cast<DocId>(docs_.size());
+    Document doc{path, terms.length_, {}};
+    doc.terms.reserve(terms.frequencies_.size());
+
+    for (const auto &[token, tf] : terms.frequencies_) {
+      auto &term = terms_[token];
+      appendVarint(term.postings, id - term.last_doc);
+      appendVarint(term.postings, tf);
+      term.last_doc = id;
+      ++term.df;
+      doc.terms.push_back(token);
+    }
+
+    docs_.push_back(std::move(doc));
+    ids_[path] = id;
+    total_length_ += terms.length_;
+    ++live_docs_;
+    // Re-adding a path tombstones its previous document.
+    compactIfNeededUnsafe();
+  }
+
+  void remove(const std::string &path) {
+    std::unique_lock lock(mutex_);
+    removeUnsafe(path);
+    compactIfNeededUnsafe();
+  }
+
+  void clear() {
+    std::unique_lock lock(mutex_);
+    terms_.clear();
+    docs_.clear();
+    ids_.clear();
+    total_length_ = 0;
+    live_docs_ = 0;
+    dead_docs_ = 0;
+  }
+
+  std::size_t size() const {
+    std::shared_lock lock(mutex_);
+    return live_docs_;
+  }
+
+  std::size_t postingBytes() const {
+    std::shared_lock lock(mutex_);
+    std::size_t bytes = 0;
+    for (const auto &[token, term] : terms_) {
+      bytes += term.postings.size();
+    }
+    return bytes;
+  }
+
+  Hits search(std::string_view query, std::size_t limit) const {
+    auto tokens = KeywordTokenizer::tokenize(query);
+    std::sort(tokens.begin(), tokens.end());
+    tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+
+    std::shared_lock lock(mutex_);
+    if (live_docs_ == 0 || limit == 0) {
+      return {};
+    }
+
+    const float avg_length =
+        static_cast<float>(total_length_) / static_cast<float>(live_docs_);
+    std::unordered_map<DocId, float> scores;
+
+    for (const auto &token : tokens) {
+      auto it = terms_.find(token);
+      if (it == terms_.end() || it->second.df == 0) {
+        continue;
+      }
+
+      const auto &term = it->second;
+      const float df = static_cast<float>(term.df);
+      const float idf = std::log(
+          1.0f + (static_cast<float>(live_docs_) - df + 0.5f) / (df + 0.5f));
+
+      forEachPosting(term, [&](DocId id, std::uint32_t tf) {
+        const auto &doc = docs_[id];
+        if (!doc.alive()) {
+          return;
+        }
+
+        const float f = static_cast<float>(tf);
+        const float norm =
+            kK1 * (1.0f - kB + kB * static_cast<float>(doc.length) / avg_length);
+        scores[id] += idf * (f * (kK1 + 1.0f)) / (f + norm);
+      });
+    }
+
+    std::vector<std::pair<DocId, float>> ranked(scores.begin(), scores.end());
+    const auto top = std::min(limit, ranked.size());
+    std::partial_sort(
+        ranked.begin(), ranked.begin() + top, ranked.end(),
+        [](const auto &a, const auto &b) { return a.second > b.second; });
+
+    Hits hits;
+    hits.reserve(top);
+    for (std::size_t i = 0; i < top; ++i) {
+      hits.emplace_back(docs_[ranked[i].first].path, ranked[i].second);
+    }
+    return hits;
+  }
+
+private:
+  struct Term {
+    std::vector<std::uint8_t> postings;
+    DocId last_doc = 0;
+    std::uint32_t df = 0;
+  };
+
+  struct Document {
+    std::string path;
+    std::uint32_t length = 0;
+    std::vector<std::string> terms;
+
+    bool alive() const { return !path.empty(); }
+  };
+
+  static void appendVarint(std::vector<std::uint8_t> &out, std::uint32_t value) {
+    while (value >= 0x80) {
+      out.push_back(static_cast<std::uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+  }
+
+  static std::uint32_t readVarint(const std::uint8_t *&it) {
+    std::uint32_t value = 0;
+    int shift = 0;
+    while (*it & 0x80) {
+      value |= static_cast<std::uint32_t>(*it++ & 0x7f) << shift;
+      shift += 7;
+    }
+    value |= static_cast<std::uint32_t>(*it++) << shift;
+    return value;
+  }
+
+  template <typename Visitor>
+  static void forEachPosting(const Term &term, Visitor &&visit) {
+    const std::uint8_t *it = term.postings.data();
+    const std::uint8_t *end = it + term.postings.size();
+
+    DocId id = 0;
+    while (it < end) {
+      id += readVarint(it);
+      const auto tf = readVarint(it);
+      visit(id, tf);
+    }
+  }
+
+  void removeUnsafe(const std::string &path) {
+    auto it = ids_.find(path);
+    if (it == ids_.end()) {
+      return;
+    }
+
+    auto &doc = docs_[it->second];
+    for (const auto &token : doc.terms) {
+      auto term = terms_.find(token);
+      if (term != terms_.end() && term->second.df > 0) {
+        --term->second.df;
+      }
+    }
+
+    total_length_ -= doc.length;
+    doc = Document{};
+    ids_.erase(it);
+    --live_docs_;
+    ++dead_docs_;
+  }
+
+  void compactIfNeededUnsafe() {
+    if (dead_docs_ > kCompactRatio * static_cast<double>(docs_.size())) {
+      compactUnsafe();
+    }
+  }
+
+  void compactUnsafe() {
+    constexpr DocId kDead = ~DocId{0};
+    std::vector<DocId> remap(docs_.size(), kDead);
+    std::vector<Document> live;
+    live.reserve(live_docs_);
+
+    for (DocId id = 0; id < docs_.size(); ++id) {
+      if (docs_[id].alive()) {
+        remap[id] = static_cast<DocId>(live.size());
+        live.push_back(std::move(docs_[id]));
+      }
+    }
+
+    for (auto it = terms_.begin(); it != terms_.end();) {
+      Term rebuilt;
+      forEachPosting(it->second, [&](DocId id, std::uint32_t tf) {
+        const auto new_id = remap[id];
+        if (new_id == kDead) {
+          return;
+        }
+        appendVarint(rebuilt.postings, new_id - rebuilt.last_doc);
+        appendVarint(rebuilt.postings, tf);
+        rebuilt.last_doc = new_id;
+        ++rebuilt.df;
+      });
+
+      if (rebuilt.df == 0) {
+        it = terms_.erase(it);
+      } else {
+        rebuilt.postings.shrink_to_fit();
+        it->second = std::move(rebuilt);
+        ++it;
+      }
+    }
+
+    docs_ = std::move(live);
+    ids_.clear();
+    for (DocId id = 0; id < docs_.size(); ++id) {
+      ids_[docs_[id].path] = id;
+    }
+    dead_docs_ = 0;
+  }
+
+  mutable std::shared_mutex mutex_;
+  std::unordered_map<std::string, Term> terms_;
+  std::vector<Document> docs_;
+  std::unordered_map<std::string, DocId> ids_;
+  std::uint64_t total_length_ = 0;
+  std::size_t live_docs_ = 0;
+  std::size_t dead_docs_ = 0;
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_KEYWORD_INDEX
@@ -0,0 +1,502 @@
+#ifndef OWL_VFS_CORE_INDEX_KNN_GRAPH
+#define OWL_VFS_CORE_INDEX_KNN_GRAPH
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "vfs/core/index/simd/kernels.hpp"
+
+namespace owl {
+
+// Approximate k-nearest-neighbour graph over file vectors, kept as HNSW
+// layers. Level-0 out-links are a file's semantic relationships; the upper
+// layers only exist to find insertion points. Insert and erase touch the
+// neighbourhood of one node (about ef_construction * m dot products), so
+// maintaining the graph never walks the whole container. Every node also
+// tracks its in-links: erasing a node repairs exactly the nodes that
+// pointed at it.
+class KnnGraph {
+public:
+  using Id = std::uint32_t;
+  using Neighbors = std::vector<std::pair<std::string, float>>;
+
+  struct Options {
+    std::size_t m = 16;
+    std::size_t ef_construction = 64;
+  };
+
+  KnnGraph() : KnnGraph(Options{}) {}
+  explicit KnnGraph(Options options)
+      : options_(options),
+        level_scale_(1.0 / std::log(static_cast<double>(
+                               std::max<std::size_t>(options.m, 2)))) {}
+
+  KnnGraph(const KnnGraph &) = delete;
+  KnnGraph &operator=(const KnnGraph &) = delete;
+
+  std::size_t size() const {
+    std::shared_lock lock(mutex_);
+    return ids_.size();
+  }
+
+  bool contains(const std::string &path) const {
+    std::shared_lock lock(mutex_);
+    return ids_.count(path) > 0;
+  }
+
+  // Bumped by every insert and erase.
+  std::uint64_t version() const {
+    return version_.load(std::memory_order_acquire);
+  }
+
+  // Rough heap footprint: vectors plus level-0 out- and in-links, which
+  // dominate the upper layers.
+  std::size_t bytes() const {
+    std::shared_lock lock(mutex_);
+    return vectors_.size() * sizeof(float) +
+           nodes_.size() * capacity(0) * 2 * sizeof(Id);
+  }
+
+  void clear() {
+    std::unique_lock lock(mutex_);
+    dim_ = 0;
+    nodes_ = {};
+    vectors_ = {};
+    free_ = {};
+    ids_ = {};
+    visited_ = {};
+    epoch_ = 0;
+    entry_ = 0;
+    max_level_ = 0;
+    version_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  // Inserts or replaces `path`. The vector is normalised internally. Returns
+  // the files whose neighbour lists changed, `path` included.
+  std::vector<std::string> insert(const std::string &path, const float *vector,
+                                  std::size_t dim) {
+    std::unique_lock lock(mutex_);
+    std::vector<std::string> touched;
+    if (dim == 0 || (dim_ != 0 && dim != dim_)) {
+      return touched;
+    }
+    dim_ = dim;
+    if (auto it = ids_.find(path); it != ids_.end()) {
+      eraseLocked(it->second, touched);
+    }
+    touched.push_back(path);
+
+    const Id id = allocate(path, vector);
+    auto &node = nodes_[id];
+    node.level = randomLevel();
+    node.out.assign(node.level + 1, {});
+    node.in.assign(node.level + 1, {});
+
+    if (ids_.size() == 1) {
+      entry_ = id;
+      max_level_ = node.level;
+      version_.fetch_add(1, std::memory_order_acq_rel);
+      return touched;
+    }
+
+    const float *query = row(id);
+    Id current = entry_;
+    for (int level = max_level_; level > node.level; --level) {
+      current = greedy(query, current, level);
+    }
+
+    for (int level = std::min(node.level, max_level_); level >= 0; --level) {
+      auto candidates = searchLayer(query, current, options_.ef_construction,
+                                    level, id);
+      if (candidates.empty()) {
+        continue;
+      }
+      current = candidates.front().second;
+
+      setLinks(id, level, select(candidates, capacity(level)));
+      for (const auto neighbor : nodes_[id].out[level]) {
+        addLink(neighbor, id, level);
+      }
+    }
+
+    for (const auto neighbor : nodes_[id].out[0]) {
+      touched.push_back(nodes_[neighbor].path);
+    }
+    if (node.level > max_level_) {
+      max_level_ = node.level;
+      entry_ = id;
+    }
+    version_.fetch_add(1, std::memory_order_acq_rel);
+    return touched;
+  }
+
+  // Returns the files whose neighbour lists were repaired.
+  std::vector<std::string> erase(const std::string &path) {
+    std::unique_lock lock(mutex_);
+    std::vector<std::string> touched;
+    auto it = ids_.find(path);
+    if (it == ids_.end()) {
+      return touched;
+    }
+    eraseLocked(it->second, touched);
+    version_.fetch_add(1, std::memory_order_acq_rel);
+    return touched;
+  }
+
+  // Up to `k` level-0 neighbours of `path`, most similar first.
+  Neighbors neighbors(const std::string &path, std::size_t k) const {
+    std::shared_lock lock(mutex_);
+    auto it = ids_.find(path);
+    if (it == ids_.end()) {
+      return {};
+    }
+
+    const auto &links = nodes_[it->second].out[0];
+    std::vector<std::pair<float, Id>> scored;
+    scored.reserve(links.size());
+    for (const auto neighbor : links) {
+      scored.emplace_back(similarity(it->second, neighbor), neighbor);
+    }
+    std::sort(scored.begin(), scored.end(),
+              [](const auto &a, const auto &b) { return a.first > b.first; });
+
+    Neighbors out;
+    out.reserve(std::min(k, scored.size()));
+    for (const auto &[score, neighbor] : scored) {
+      if (out.size() == k) {
+        break;
+      }
+      out.emplace_back(nodes_[neighbor].path, score);
+    }
+    return out;
+  }
+
+  // Level-0 edges by internal id, taken under one lock. Ids are slots:
+  // paths[id] is empty for a free slot, which has no edges.
+  struct Adjacency {
+    std::uint64_t version = 0;
+    std::vector<std::string> paths;
+    std::vector<std::pair<Id, Id>> edges;
+    std::vector<float> similarities;
+  };
+
+  Adjacency adjacency() const {
+    std::shared_lock lock(mutex_);
+    Adjacency out;
+    out.version = version();
+    out.paths.resize(nodes_.size());
+    for (Id id = 0; id < nodes_.size(); ++id) {
+      if (!nodes_[id].live) {
+        continue;
+      }
+      out.paths[id] = nodes_[id].path;
+      for (const auto neighbor : nodes_[id].out[0]) {
+        out.edges.emplace_back(id, neighbor);
+        out.similarities.push_back(similarity(id, neighbor));
+      }
+    }
+    return out;
+  }
+
+  // Calls visit(from, to, similarity) for every level-0 edge.
+  template <typename Visitor> void forEachEdge(Visitor &&visit) const {
+    std::shared_lock lock(mutex_);
+    for (Id id = 0; id < nodes_.size(); ++id) {
+      if (!nodes_[id].live) {
+        continue;
+      }
+      for (const auto neighbor : nodes_[id].out[0]) {
+        visit(nodes_[id].path, nodes_[neighbor].path,
+              similarity(id, neighbor));
+      }
+    }
+  }
+
+private:
+  struct Node {
+    std::string path;
+    int level = 0;
+    bool live = false;
+    std::vector<std::vector<Id>> out;
+    std::vector<std::vector<Id>> in;
+  };
+
+  // (similarity, id), best first.
+  using Scored = std::vector<std::pair<float, Id>>;
+
+  std::size_t capacity(int level) const {
+    return level == 0 ? options_.m * 2 : options_.m;
+  }
+
+  int randomLevel() {
+    std::uniform_real_distribution<double> uniform(
+        std::numeric_limits<double>::min(), 1.0);
+    return static_cast<int>(-std::log(uniform(rng_)) * level_scale_);
+  }
+
+  const float *row(Id id) const { return vectors_.data() + id * dim_; }
+
+  float similarity(const float *query, Id id) const {
+    return simd::kernels().dot(query, row(id), dim_);
+  }
+  float similarity(Id a, Id b) const { return similarity(row(a), b); }
+
+  Id allocate(const std::string &path, const float *vector) {
+    Id id;
+    if (!free_.empty()) {
+      id = free_.back();
+      free_.pop_back();
+    } else {
+      id = static_cast<Id>(nodes_.size());
+      nodes_.emplace_back();
+      vectors_.resize(vectors_.size() + dim_);
+      visited_.push_back(0);
+    }
+
+    float *out = vectors_.data() + id * dim_;
+    float norm = 0;
+    for (std::size_t i = 0; i < dim_; ++i) {
+      norm += vector[i] * vector[i];
+    }
+    const float scale = norm > 0 ? 1.0f / std::sqrt(norm) : 0.0f;
+    for (std::size_t i = 0; i < dim_; ++i) {
+      out[i] = vector[i] * scale;
+    }
+
+    nodes_[id].path = path;
+    nodes_[id].live = true;
+    ids_.emplace(path, id);
+    return id;
+  }
+
+  Id greedy(const float *query, Id current, int level) const {
+    float best = similarity(query, current);
+    for (bool moved = true; moved;) {
+      moved = false;
+      for (const auto neighbor : nodes_[current].out[level]) {
+        const float score = similarity(query, neighbor);
+        if (score > best) {
+          best = score;
+          current = neighbor;
+          moved = true;
+        }
+      }
+    }
+    return current;
+  }
+
+  // Beam search on one layer; `skip` is the node being inserted.
+  Scored searchLayer(const float *query, Id entry, std::size_t ef, int level,
+                     Id skip) {
+    if (++epoch_ == 0) {
+      std::fill(visited_.begin(), visited_.end(), 0);
+      epoch_ = 1;
+    }
+    const auto worse = [](const auto &a, const auto &b) {
+      return a.first > b.first;
+    };
+    const auto better = [](const auto &a, const auto &b) {
+      return a.first < b.first;
+    };
+    std::priority_queue<std::pair<float, Id>, Scored, decltype(better)>
+        frontier(better);
+    std::priority_queue<std::pair<float, Id>, Scored, decltype(worse)> found(
+        worse);
+
+    visited_[entry] = epoch_;
+    visited_[skip] = epoch_;
+    const float first = similarity(query, entry);
+    frontier.emplace(first, entry);
+    found.emplace(first, entry);
+
+    while (!frontier.empty()) {
+      const auto [score, id] = frontier.top();
+      if (found.size() >= ef && score < found.top().first) {
+        break;
+      }
+      frontier.pop();
+
+      for (const auto neighbor : nodes_[id].out[level]) {
+        if (visited_[neighbor] == epoch_) {
+          continue;
+        }
+        visited_[neighbor] = epoch_;
+        const float candidate = similarity(query, neighbor);
+        if (found.size() < ef || candidate > found.top().first) {
+          frontier.emplace(candidate, neighbor);
+          found.emplace(candidate, neighbor);
+          if (found.size() > ef) {
+            found.pop();
+          }
+        }
+      }
+    }
+
+    Scored out;
+    out.reserve(found.size());
+    for (; !found.empty(); found.pop()) {
+      out.push_back(found.top());
+    }
+    std::reverse(out.begin(), out.end());
+    return out;
+  }
+
+  // HNSW neighbour heuristic: keep a candidate only if it is closer to the
+  // node than to every neighbour already kept, then top up with the best
+  // of the rest so level 0 stays a k-nearest list. `candidates` must be
+  // sorted best first.
+  std::vector<Id> select(const Scored &candidates, std::size_t limit) const {
+    std::vector<Id> kept;
+    std::vector<Id> pruned;
+    kept.reserve(limit);
+    for (const auto &[score, id] : candidates) {
+      if (kept.size() == limit) {
+        break;
+      }
+      const bool diverse =
+          std::all_of(kept.begin(), kept.end(), [&, score = score, id = id](Id other) {
+            return similarity(id, other) < score;
+          });
+      (diverse ? kept : pruned).push_back(id);
+    }
+    for (const auto id : pruned) {
+      if (kept.size() == limit) {
+        break;
+      }
+      kept.push_back(id);
+    }
+    return kept;
+  }
+
+  void setLinks(Id id, int level, std::vector<Id> links) {
+    for (const auto old : nodes_[id].out[level]) {
+      auto &in = nodes_[old].in[level];
+      in.erase(std::remove(in.begin(), in.end(), id), in.end());
+    }
+    for (const auto neighbor : links) {
+      nodes_[neighbor].in[level].push_back(id);
+    }
+    nodes_[id].out[level] = std::move(links);
+  }
+
+  void addLink(Id from, Id to, int level) {
+    auto &out = nodes_[from].out[level];
+    if (out.size() < capacity(level)) {
+      out.push_back(to);
+      nodes_[to].in[level].push_back(from);
+      return;
+    }
+    relink(from, level, out, {to});
+  }
+
+  // Re-selects `from`'s links at `level` among its current ones plus `extra`.
+  void relink(Id from, int level, const std::vector<Id> &current,
+              const std::vector<Id> &extra) {
+    Scored candidates;
+    candidates.reserve(current.size() + extra.size());
+    const auto consider = [&](Id id) {
+      if (id == from || !nodes_[id].live ||
+          std::any_of(candidates.begin(), candidates.end(),
+                      [id](const auto &c) { return c.second == id; })) {
+        return;
+      }
+      candidates.emplace_back(similarity(from, id), id);
+    };
+    for (const auto id : current) {
+      consider(id);
+    }
+    for (const auto id : extra) {
+      consider(id);
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto &a, const auto &b) { return a.first > b.first; });
+    setLinks(from, level, select(candidates, capacity(level)));
+  }
+
+  void eraseLocked(Id id, std::vector<std::string> &touched) {
+    auto &node = nodes_[id];
+    node.live = false;
+    ids_.erase(node.path);
+    if (entry_ == id) {
+      replaceEntry(id);
+    }
+
+    // Every node that pointed here picks replacements from its own links and
+    // the erased node's links, so the neighbourhood stays connected.
+    for (int level = 0; level <= node.level; ++level) {
+      const auto incoming = node.in[level];
+      const auto outgoing = node.out[level];
+      for (const auto from : incoming) {
+        if (level == 0) {
+          touched.push_back(nodes_[from].path);
+        }
+        auto links = nodes_[from].out[level];
+        links.erase(std::remove(links.begin(), links.end(), id), links.end());
+        relink(from, level, links, outgoing);
+      }
+      setLinks(id, level, {});
+    }
+
+    node = Node{};
+    free_.push_back(id);
+  }
+
+  void replaceEntry(Id erased) {
+    if (ids_.empty()) {
+      max_level_ = 0;
+      return;
+    }
+    // The erased node's own top-layer neighbours are the natural successors;
+    // the full scan only runs when it had none left.
+    const auto &node = nodes_[erased];
+    std::optional<Id> best;
+    for (int level = node.level; level >= 0 && !best; --level) {
+      for (const auto id : node.out[level]) {
+        if (nodes_[id].live &&
+            (!best || nodes_[id].level > nodes_[*best].level)) {
+          best = id;
+        }
+      }
+    }
+    if (!best) {
+      for (const auto &[path, id] : ids_) {
+        if (!best || nodes_[id].level > nodes_[*best].level) {
+          best = id;
+        }
+      }
+    }
+    entry_ = *best;
+    max_level_ = nodes_[entry_].level;
+  }
+
+  Options options_;
+  double level_scale_;
+  mutable std::shared_mutex mutex_;
+  std::size_t dim_ = 0;
+  std::vector<Node> nodes_;
+  std::vector<float> vectors_;
+  std::vector<Id> free_;
+  std::unordered_map<std::string, Id> ids_;
+  std::vector<std::uint32_t> visited_;
+  std::uint32_t epoch_ = 0;
+  Id entry_ = 0;
+  int max_level_ = 0;
+  std::mt19937 rng_{0x6f776c};
+  std::atomic<std::uint64_t> version_{0};
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_KNN_GRAPH
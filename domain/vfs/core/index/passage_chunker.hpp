@@ -0,0 +1,177 @@
+#ifndef OWL_VFS_CORE_INDEX_PASSAGE_CHUNKER
+#define OWL_VFS_CORE_INDEX_PASSAGE_CHUNKER
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace owl {
+
+struct Passage {
+  std::uint64_t offset = 0;
+  std::uint32_t length = 0;
+  std::string text;
+};
+
+// Byte sources for PassageChunker: read() fills up to `n` bytes and returns
+// how many it wrote, 0 at the end.
+class StringSource {
+public:
+  explicit StringSource(std::string_view text) : text_(text) {}
+
+  std::size_t read(char *out, std::size_t n) {
+    const auto count = std::min(n, text_.size() - position_);
+    std::copy_n(text_.data() + position_, count, out);
+    position_ += count;
+    return count;
+  }
+
+private:
+  std::string_view text_;
+  std::size_t position_ = 0;
+};
+
+class FileSource {
+public:
+  explicit FileSource(const std::string &path)
+      : in_(path, std::ios::binary) {}
+
+  bool good() const { return static_cast<bool>(in_); }
+
+  std::size_t read(char *out, std::size_t n) {
+    in_.read(out, static_cast<std::streamsize>(n));
+    return static_cast<std::size_t>(in_.gcount());
+  }
+
+private:
+  std::ifstream in_;
+};
+
+// Splits text into passages of roughly `target` bytes, cutting at the
+// strongest boundary available between `min` and `max` bytes: a blank line,
+// then a line break, then the end of a sentence, then any whitespace, and
+// only as a last resort mid-word (never inside a UTF-8 sequence). Reads the
+// source in blocks, so memory stays around `max` bytes however large the file.
+class PassageChunker {
+public:
+  struct Options {
+    std::size_t min = 256;
+    std::size_t target = 1024;
+    std::size_t max = 2048;
+  };
+
+  PassageChunker() = default;
+  explicit PassageChunker(Options options) : options_(options) {
+    options_.max = std::max<std::size_t>(options_.max, 2);
+    options_.min = std::min(options_.min, options_.max - 1);
+    options_.target = std::clamp(options_.target, options_.min, options_.max);
+  }
+
+  const Options &options() const { return options_; }
+
+  // Calls visit(const Passage &) for every passage with non-blank text.
+  template <typename Source, typename Visitor>
+  void chunk(Source &source, Visitor &&visit) const {
+    std::string buffer;
+    buffer.reserve(options_.max * 2);
+    std::uint64_t offset = 0;
+    bool eof = false;
+
+    while (true) {
+      while (!eof && buffer.size() < options_.max) {
+        const auto size = buffer.size();
+        buffer.resize(size + options_.max);
+        const auto got = source.read(buffer.data() + size, options_.max);
+        buffer.resize(size + got);
+        eof = got == 0;
+      }
+      if (buffer.empty()) {
+        return;
+      }
+
+      const auto cut = eof && buffer.size() <= options_.max
+                           ? buffer.size()
+                           : boundary(buffer);
+      emit(buffer.substr(0, cut), offset, visit);
+      buffer.erase(0, cut);
+      offset += cut;
+    }
+  }
+
+private:
+  template <typename Visitor>
+  static void emit(std::string text, std::uint64_t offset, Visitor &visit) {
+    if (std::all_of(text.begin(), text.end(), [](unsigned char c) {
+          return std::isspace(c) != 0;
+        })) {
+      return;
+    }
+    const auto length = static_cast<std::uint32_t>(text.size());
+    visit(Passage{offset, length, std::move(text)});
+  }
+
+  // Position just after the best cut in buffer[min, max].
+  std::size_t boundary(std::string_view buffer) const {
+    const auto limit = std::min(buffer.size(), options_.max);
+    const auto window = buffer.substr(0, limit);
+
+    // Prefer the cut closest to the target among those of equal strength.
+    const auto best = [&](auto matches) -> std::size_t {
+      std::size_t found = 0;
+      for (std::size_t i = options_.min; i < limit; ++i) {
+        if (!matches(i)) {
+          continue;
+        }
+        const auto cut = i + 1;
+        const auto distance = [&](std::size_t c) {
+          return c > options_.target ? c - options_.target
+                                     : options_.target - c;
+        };
+        if (found == 0 || distance(cut) < distance(found)) {
+          found = cut;
+        }
+        if (cut > options_.target) {
+          break;
+        }
+      }
+      return found;
+    };
+
+    if (auto cut = best([&](std::size_t i) {
+          return window[i] == '\n' && i > 0 && window[i - 1] == '\n';
+        })) {
+      return cut;
+    }
+    if (auto cut = best([&](std::size_t i) { return window[i] == '\n'; })) {
+      return cut;
+    }
+    if (auto cut = best([&](std::size_t i) {
+          return i > 0 && (window[i] == ' ' || window[i] == '\t') &&
+                 (window[i - 1] == '.' || window[i - 1] == '!' ||
+                  window[i - 1] == '?');
+        })) {
+      return cut;
+    }
+    if (auto cut = best([&](std::size_t i) {
+          return std::isspace(static_cast<unsigned char>(window[i])) != 0;
+        })) {
+      return cut;
+    }
+
+    auto cut = limit;
+    while (cut > 1 && cut < buffer.size() &&
+           (static_cast<unsigned char>(buffer[cut]) & 0xC0) == 0x80) {
+      --cut;
+    }
+    return cut;
+  }
+
+  Options options_;
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_PASSAGE_CHUNKER
@@ -0,0 +1,200 @@
+#ifndef OWL_VFS_CORE_INDEX_PASSAGE_INDEX
+#define OWL_VFS_CORE_INDEX_PASSAGE_INDEX
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <infrastructure/result.hpp>
+
+#include "vfs/core/index/passage_chunker.hpp"
+#include "vfs/core/index/versioned_vector_index.hpp"
+
+namespace owl {
+
+namespace fs = std::filesystem;
+
+struct PassageHit {
+  std::string path;
+  std::uint64_t offset = 0;
+  std::uint32_t length = 0;
+  float score = 0;
+};
+
+// One vector per passage, keyed "<path>#<offset>+<length>" in a
+// VersionedVectorIndex of its own, so passage queries get the same lock-free
+// snapshots, index migration and exact re-ranking as whole-file vectors. The
+// per-file key lists are only needed to drop a file's old passages.
+class PassageIndex {
+public:
+  using Error = std::runtime_error;
+  using Embedded = std::vector<std::pair<Passage, std::vector<float>>>;
+
+  static constexpr const char *kDirectory = "passages";
+
+  static std::string key(const std::string &path, std::uint64_t offset,
+                         std::uint32_t length) {
+    return path + '#' + std::to_string(offset) + '+' + std::to_string(length);
+  }
+
+  static std::optional<PassageHit> parse(const std::string &key,
+                                         float score = 0) {
+    const auto hash = key.rfind('#');
+    const auto plus = key.rfind('+');
+    if (hash == std::string::npos || plus == std::string::npos ||
+        plus < hash) {
+      return std::nullopt;
+    }
+    try {
+      return PassageHit{
+          key.substr(0, hash),
+          std::stoull(key.substr(hash + 1, plus - hash - 1)),
+          static_cast<std::uint32_t>(std::stoul(key.substr(plus + 1))), score};
+    } catch (const std::exception &) {
+      return std::nullopt;
+    }
+  }
+
+  static fs::path directory(const fs::path &state_dir) {
+    return state_dir / kDirectory;
+  }
+
+  VersionedVectorIndex &vectors() { return vectors_; }
+  const VersionedVectorIndex &vectors() const { return vectors_; }
+
+  void configure(IndexConfig config) { vectors_.configure(std::move(config)); }
+
+  // Loads the passage snapshot (if any) and attaches its exact store.
+  void load(const fs::path &state_dir) {
+    const auto dir = directory(state_dir);
+    if (auto snapshot = VectorIndex::load(dir); snapshot.is_ok()) {
+      vectors_.reset(snapshot.value());
+    }
+    if (auto r = vectors_.attach(dir); !r.is_ok()) {
+      spdlog::warn("No exact passage store in {}: {}", dir.string(),
+                   r.error().what());
+    }
+
+    std::lock_guard lock(mutex_);
+    keys_.clear();
+    for (auto &passage : vectors_.snapshot()->paths()) {
+      if (auto hit = parse(passage)) {
+        keys_[hit->path].push_back(std::move(passage));
+      }
+    }
+  }
+
+  core::Result<void> save(const fs::path &state_dir) {
+    return vectors_.save(directory(state_dir));
+  }
+
+  static fs::file_time_type snapshotTime(const fs::path &state_dir) {
+    return VectorIndex::snapshotTime(directory(state_dir));
+  }
+
+  bool contains(const std::string &path) const {
+    std::lock_guard lock(mutex_);
+    return keys_.count(path) > 0;
+  }
+
+  std::vector<std::string> files() const {
+    std::lock_guard lock(mutex_);
+    std::vector<std::string> out;
+    out.reserve(keys_.size());
+    for (const auto &[path, keys] : keys_) {
+      out.push_back(path);
+    }
+    return out;
+  }
+
+  std::size_t fileCount() const {
+    std::lock_guard lock(mutex_);
+    return keys_.size();
+  }
+
+  std::size_t size() const { return vectors_.snapshot()->size(); }
+
+  // Drops the file's previous passages and stores `passages` in their place.
+  core::Result<void> replace(const std::string &path, Embedded passages) {
+    return update(path, std::move(passages), true);
+  }
+
+  // Adds more passages of a file being streamed in after replace().
+  core::Result<void> append(const std::string &path, Embedded passages) {
+    return update(path, std::move(passages), false);
+  }
+
+  void remove(const std::string &path) {
+    std::lock_guard lock(mutex_);
+    auto it = keys_.find(path);
+    if (it == keys_.end()) {
+      return;
+    }
+    vectors_.apply(it->second, {});
+    keys_.erase(it);
+  }
+
+  void unload() {
+    std::lock_guard lock(mutex_);
+    vectors_.unload();
+    keys_ = {};
+  }
+
+  std::vector<PassageHit> search(const std::vector<float> &query, std::size_t k,
+                                 const VectorSearchParams &tuning = {},
+                                 const SearchFilter &filter = {}) const {
+    std::vector<PassageHit> out;
+    for (const auto &[passage, score] :
+         vectors_.snapshot()->search(query, k, tuning, filter)) {
+      if (auto hit = parse(passage, score)) {
+        out.push_back(std::move(*hit));
+      }
+    }
+    return out;
+  }
+
+private:
+  core::Result<void> update(const std::string &path, Embedded passages,
+                            bool replace) {
+    std::vector<std::pair<std::string, std::vector<float>>> upserts;
+    std::vector<std::string> keys;
+    upserts.reserve(passages.size());
+    keys.reserve(passages.size());
+    for (auto &[passage, vector] : passages) {
+      keys.push_back(key(path, passage.offset, passage.length));
+      upserts.emplace_back(keys.back(), std::move(vector));
+    }
+
+    std::lock_guard lock(mutex_);
+    const auto it = keys_.find(path);
+    const bool drop = replace && it != keys_.end();
+
+    auto r = vectors_.apply(drop ? it->second : std::vector<std::string>{},
+                            std::move(upserts));
+    if (!r.is_ok()) {
+      return r;
+    }
+    if (drop) {
+      keys_.erase(it);
+    }
+    if (!keys.empty()) {
+      auto &stored = keys_[path];
+      stored.insert(stored.end(), std::make_move_iterator(keys.begin()),
+                    std::make_move_iterator(keys.end()));
+    }
+    return core::Result<void, Error>::Ok();
+  }
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::vector<std::string>> keys_;
+  VersionedVectorIndex vectors_;
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_PASSAGE_INDEX
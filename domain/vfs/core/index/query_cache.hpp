@@ -0,0 +1,191 @@
+#ifndef OWL_VFS_CORE_INDEX_QUERY_CACHE
+#define OWL_VFS_CORE_INDEX_QUERY_CACHE
+
+#include <cctype>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <infrastructure/result.hpp>
+
+#include "vfs/core/index/index_config.hpp"
+#include "vfs/core/index/rank_fusion.hpp"
+
+namespace owl {
+
+// Lowercases and collapses whitespace so that trivially different spellings of
+// the same dashboard query share cache entries.
+inline std::string normalizeQuery(std::string_view query) {
+  std::string out;
+  out.reserve(query.size());
+  for (const char ch : query) {
+    const auto c = static_cast<unsigned char>(ch);
+    if (std::isspace(c)) {
+      if (!out.empty() && out.back() != ' ') {
+        out.push_back(' ');
+      }
+      continue;
+    }
+    out.push_back(static_cast<char>(std::tolower(c)));
+  }
+  if (!out.empty() && out.back() == ' ') {
+    out.pop_back();
+  }
+  return out;
+}
+
+struct CacheStats {
+  std::uint64_t hits = 0;
+  std::uint64_t misses = 0;
+  std::size_t entries = 0;
+
+  double hitRate() const {
+    const auto total = hits + misses;
+    return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+  }
+};
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+public:
+  explicit LruCache(std::size_t capacity)
+      : capacity_(capacity == 0 ? 1 : capacity) {}
+
+  std::optional<Value> get(const Key &key) {
+    std::lock_guard lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      ++misses_;
+      return std::nullopt;
+    }
+
+    ++hits_;
+    order_.splice(order_.begin(), order_, it->second);
+    return it->second->second;
+  }
+
+  void put(Key key, Value value) {
+    std::lock_guard lock(mutex_);
+    if (auto it = entries_.find(key); it != entries_.end()) {
+      it->second->second = std::move(value);
+      order_.splice(order_.begin(), order_, it->second);
+      return;
+    }
+
+    order_.emplace_front(std::move(key), std::move(value));
+    entries_.emplace(order_.front().first, order_.begin());
+    if (entries_.size() > capacity_) {
+      entries_.erase(order_.back().first);
+      order_.pop_back();
+    }
+  }
+
+  CacheStats stats() const {
+    std::lock_guard lock(mutex_);
+    return {hits_, misses_, entries_.size()};
+  }
+
+private:
+  using Order = std::list<std::pair<Key, Value>>;
+
+  const std::size_t capacity_;
+  mutable std::mutex mutex_;
+  Order order_;
+  std::unordered_map<Key, typename Order::iterator, Hash> entries_;
+  std::uint64_t hits_ = 0;
+  std::uint64_t misses_ = 0;
+};
+
+// `generation` is the container's search generation at the time the query
+// ran. Any write bumps it, so entries for older generations are simply never
+// looked up again and age out of the LRU.
+struct ResultCacheKey {
+  std::string container_id;
+  std::uint64_t generation = 0;
+  SearchMode mode = SearchMode::Semantic;
+  std::string query;
+  int limit = 0;
+  VectorSearchParams tuning;
+  std::string filter; // SearchFilter::key()
+
+  bool operator==(const ResultCacheKey &) const = default;
+};
+
+struct ResultCacheKeyHash {
+  std::size_t operator()(const ResultCacheKey &key) const {
+    std::size_t h = std::hash<std::string>{}(key.container_id);
+    const auto mix = [&h](std::size_t v) {
+      h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    };
+    mix(std::hash<std::uint64_t>{}(key.generation));
+    mix(static_cast<std::size_t>(key.mode));
+    mix(std::hash<std::string>{}(key.query));
+    mix(std::hash<int>{}(key.limit));
+    mix(std::hash<int>{}(key.tuning.nprobe));
+    mix(std::hash<int>{}(key.tuning.ef_search));
+    mix(std::hash<std::string>{}(key.filter));
+    return h;
+  }
+};
+
+// Two levels: query embeddings, shared by every container because they all
+// load the same model, and per-container results keyed by generation.
+class QueryCache {
+public:
+  using Error = std::runtime_error;
+  using Vector = std::shared_ptr<const std::vector<float>>;
+  using Hits = std::vector<std::pair<std::string, float>>;
+  using HitsPtr = std::shared_ptr<const Hits>;
+
+  static constexpr std::size_t kEmbeddingEntries = 4096;
+  static constexpr std::size_t kResultEntries = 2048;
+
+  // `embed` is only called on a miss and must return
+  // core::Result<std::vector<float>>.
+  template <typename Embed>
+  core::Result<Vector> embedding(const std::string &normalized, Embed &&embed) {
+    if (auto cached = embeddings_.get(normalized)) {
+      return core::Result<Vector, Error>::Ok(std::move(*cached));
+    }
+
+    auto embedded = embed();
+    if (!embedded.is_ok()) {
+      return core::Result<Vector, Error>::Error(embedded.error());
+    }
+
+    auto vector =
+        std::make_shared<const std::vector<float>>(std::move(embedded.value()));
+    embeddings_.put(normalized, vector);
+    return core::Result<Vector, Error>::Ok(std::move(vector));
+  }
+
+  std::optional<HitsPtr> results(const ResultCacheKey &key) {
+    return results_.get(key);
+  }
+
+  HitsPtr storeResults(ResultCacheKey key, Hits hits) {
+    auto shared = std::make_shared<const Hits>(std::move(hits));
+    results_.put(std::move(key), shared);
+    return shared;
+  }
+
+  CacheStats embeddingStats() const { return embeddings_.stats(); }
+  CacheStats resultStats() const { return results_.stats(); }
+
+private:
+  LruCache<std::string, Vector> embeddings_{kEmbeddingEntries};
+  LruCache<ResultCacheKey, HitsPtr, ResultCacheKeyHash> results_{
+      kResultEntries};
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_QUERY_CACHE
@@ -0,0 +1,61 @@
+#ifndef OWL_VFS_CORE_INDEX_RANK_FUSION
+#define OWL_VFS_CORE_INDEX_RANK_FUSION
+
+#include <algorithm>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace owl {
+
+enum class SearchMode { Semantic, Keyword, Fused };
+
+inline SearchMode parseSearchMode(std::string_view mode) {
+  if (mode == "keyword") {
+    return SearchMode::Keyword;
+  }
+  if (mode == "fused" || mode == "hybrid") {
+    return SearchMode::Fused;
+  }
+  return SearchMode::Semantic;
+}
+
+inline constexpr float kRrfK = 60.0f;
+
+// What the item at zero-based `rank` of a list contributes under RRF.
+inline float reciprocalRank(std::size_t rank, float k = kRrfK) {
+  return 1.0f / (k + static_cast<float>(rank + 1));
+}
+
+// Reciprocal-rank fusion: every list contributes 1 / (k + rank) per path, so
+// lists with incomparable score scales (cosine vs BM25) can be merged without
+// normalisation.
+inline std::vector<std::pair<std::string, float>> reciprocalRankFusion(
+    std::initializer_list<const std::vector<std::pair<std::string, float>> *>
+        lists,
+    std::size_t limit, float k = kRrfK) {
+  std::unordered_map<std::string, float> fused;
+
+  for (const auto *list : lists) {
+    for (std::size_t rank = 0; rank < list->size(); ++rank) {
+      fused[(*list)[rank].first] += reciprocalRank(rank, k);
+    }
+  }
+
+  std::vector<std::pair<std::string, float>> out(fused.begin(), fused.end());
+  const auto top = std::min(limit, out.size());
+  std::partial_sort(out.begin(), out.begin() + top, out.end(),
+                    [](const auto &a, const auto &b) {
+                      return a.second != b.second ? a.second > b.second
+                                                  : a.first < b.first;
+                    });
+  out.resize(top);
+  return out;
+}
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_RANK_FUSION
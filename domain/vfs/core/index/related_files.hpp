@@ -0,0 +1,114 @@
+#ifndef OWL_VFS_CORE_INDEX_RELATED_FILES
+#define OWL_VFS_CORE_INDEX_RELATED_FILES
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "vfs/core/index/rank_fusion.hpp"
+
+namespace owl {
+
+struct RelatedList {
+  std::vector<std::pair<std::string, float>> files; // best first
+  std::string text; // "path\tscore\n" per file, as served by user.owl.related
+};
+
+// Materialised top-N related files per file. Lookups are one hash probe and
+// hand out an immutable list; the lists are recomputed in the background for
+// the files marked dirty by graph or access-model changes.
+class RelatedFiles {
+public:
+  using Entry = std::shared_ptr<const RelatedList>;
+  using Scored = std::vector<std::pair<std::string, float>>;
+
+  static constexpr std::size_t kTop = 10;
+
+  // Blends kNN-graph neighbours with likely next files by rank, so a strong
+  // transition is not drowned out by a cluster of near-duplicate embeddings;
+  // a file found by both lists gets both shares.
+  static Scored blend(const Scored &neighbors, const Scored &successors,
+                      std::size_t k = kTop) {
+    return reciprocalRankFusion({&neighbors, &successors}, k);
+  }
+
+  Entry lookup(const std::string &path) const {
+    std::shared_lock lock(mutex_);
+    auto it = entries_.find(path);
+    return it == entries_.end() ? nullptr : it->second;
+  }
+
+  void store(const std::string &path, Scored files) {
+    auto entry = std::make_shared<RelatedList>();
+    std::ostringstream text;
+    for (const auto &[file, score] : files) {
+      text << file << '\t' << score << '\n';
+    }
+    entry->files = std::move(files);
+    entry->text = text.str();
+
+    std::unique_lock lock(mutex_);
+    entries_[path] = std::move(entry);
+  }
+
+  void erase(const std::string &path) {
+    {
+      std::unique_lock lock(mutex_);
+      entries_.erase(path);
+    }
+    std::lock_guard lock(dirty_mutex_);
+    dirty_.erase(path);
+  }
+
+  void invalidate(const std::vector<std::string> &paths) {
+    std::lock_guard lock(dirty_mutex_);
+    dirty_.insert(paths.begin(), paths.end());
+  }
+
+  // Up to `n` dirty files, removed from the dirty set.
+  std::vector<std::string> takeDirty(std::size_t n) {
+    std::lock_guard lock(dirty_mutex_);
+    std::vector<std::string> out;
+    out.reserve(std::min(n, dirty_.size()));
+    for (auto it = dirty_.begin(); it != dirty_.end() && out.size() < n;) {
+      out.push_back(std::move(dirty_.extract(it++).value()));
+    }
+    return out;
+  }
+
+  void clear() {
+    {
+      std::unique_lock lock(mutex_);
+      entries_ = {};
+    }
+    std::lock_guard lock(dirty_mutex_);
+    dirty_ = {};
+  }
+
+  std::size_t pending() const {
+    std::lock_guard lock(dirty_mutex_);
+    return dirty_.size();
+  }
+
+  std::size_t size() const {
+    std::shared_lock lock(mutex_);
+    return entries_.size();
+  }
+
+private:
+  mutable std::shared_mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  mutable std::mutex dirty_mutex_;
+  std::unordered_set<std::string> dirty_;
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_RELATED_FILES
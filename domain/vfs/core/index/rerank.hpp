@@ -0,0 +1,98 @@
+#ifndef OWL_VFS_CORE_INDEX_RERANK
+#define OWL_VFS_CORE_INDEX_RERANK
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "vfs/core/index/hub_rank.hpp"
+#include "vfs/core/index/simd/kernels.hpp"
+
+namespace owl {
+
+// Candidate list kept as parallel arrays so scoring passes run over a
+// contiguous float buffer instead of strided (string, float) pairs.
+struct ScoreBuffer {
+  using Hits = std::vector<std::pair<std::string, float>>;
+
+  std::vector<std::string> paths;
+  std::vector<float> scores;
+
+  ScoreBuffer() = default;
+
+  explicit ScoreBuffer(const Hits &hits) {
+    paths.reserve(hits.size());
+    scores.reserve(hits.size());
+    for (const auto &[path, score] : hits) {
+      paths.push_back(path);
+      scores.push_back(score);
+    }
+  }
+
+  std::size_t size() const { return paths.size(); }
+
+  // Min-max scales the scores to [0, 1]; a flat list becomes all ones.
+  void normalize() {
+    if (scores.empty()) {
+      return;
+    }
+    const auto [lo, hi] = std::minmax_element(scores.begin(), scores.end());
+    const float min = *lo;
+    const float range = *hi - min;
+    for (auto &score : scores) {
+      score = range > 0 ? (score - min) / range : 1.0f;
+    }
+  }
+
+  // Only the first k positions are ordered.
+  Hits topK(std::size_t k) const {
+    std::vector<std::size_t> order(size());
+    std::iota(order.begin(), order.end(), 0);
+
+    const auto top = std::min(k, order.size());
+    std::partial_sort(order.begin(), order.begin() + top, order.end(),
+                      [this](std::size_t a, std::size_t b) {
+                        return scores[a] > scores[b];
+                      });
+
+    Hits out;
+    out.reserve(top);
+    for (std::size_t i = 0; i < top; ++i) {
+      out.emplace_back(paths[order[i]], scores[order[i]]);
+    }
+    return out;
+  }
+};
+
+// Boosts vector hits by each file's PageRank over the relationship graph:
+//
+//   score = (1 - w) * cosine' + w * hub'
+//
+// where both terms are min-max normalised over the candidates. Files the
+// ranking has not reached yet get no boost.
+inline std::vector<std::pair<std::string, float>>
+rerankByHubs(const std::vector<std::pair<std::string, float>> &candidates,
+             const HubRanking &ranking, std::size_t k,
+             float hub_weight = 0.3f) {
+  ScoreBuffer buffer(candidates);
+  buffer.normalize();
+
+  ScoreBuffer hubs;
+  hubs.scores.reserve(buffer.size());
+  for (const auto &path : buffer.paths) {
+    const auto it = ranking.scores.find(path);
+    hubs.scores.push_back(it != ranking.scores.end() ? it->second : 0.0f);
+  }
+  hubs.normalize();
+
+  simd::kernels().fuse(buffer.scores.data(), 1.0f - hub_weight,
+                       hubs.scores.data(), hub_weight, buffer.scores.data(),
+                       buffer.size());
+  return buffer.topK(k);
+}
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_RERANK
@@ -0,0 +1,102 @@
+#ifndef OWL_VFS_CORE_INDEX_SEARCH_FILTER
+#define OWL_VFS_CORE_INDEX_SEARCH_FILTER
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace owl {
+
+namespace fs = std::filesystem;
+
+// Per-file attributes stored next to each vector.
+struct FileMeta {
+  std::int64_t mtime = 0; // seconds since the epoch, 0 when unknown
+  std::string category;
+};
+
+inline std::int64_t epochSeconds(fs::file_time_type time) {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             std::chrono::file_clock::to_sys(time).time_since_epoch())
+      .count();
+}
+
+// Conjunction of optional predicates. Path, category and mtime are evaluated
+// per file inside the index; labels belong to the container as a whole and
+// only decide whether it is searched at all.
+struct SearchFilter {
+  std::string path_prefix;
+  std::optional<std::string> category;
+  std::optional<std::int64_t> mtime_from;
+  std::optional<std::int64_t> mtime_to;
+  std::vector<std::string> labels; // "key=value"
+
+  bool empty() const { return path_prefix.empty() && !perFileMeta(); }
+
+  // Whether evaluating the filter needs FileMeta rather than just the path.
+  bool perFileMeta() const {
+    return category.has_value() || mtime_from.has_value() ||
+           mtime_to.has_value();
+  }
+
+  bool matchesPath(const std::string &path) const {
+    return path.compare(0, path_prefix.size(), path_prefix) == 0;
+  }
+
+  bool matchesMeta(std::int64_t mtime, const std::string &file_category) const {
+    return (!category || file_category == *category) &&
+           (!mtime_from || mtime >= *mtime_from) &&
+           (!mtime_to || mtime <= *mtime_to);
+  }
+
+  // A file without metadata only passes filters that do not look at it.
+  bool matches(const std::string &path, const FileMeta *meta) const {
+    if (!matchesPath(path)) {
+      return false;
+    }
+    if (!perFileMeta()) {
+      return true;
+    }
+    return meta && matchesMeta(meta->mtime, meta->category);
+  }
+
+  // Canonical text form, used to key cached results.
+  std::string key() const {
+    std::ostringstream out;
+    out << path_prefix << '\x1f' << category.value_or("") << '\x1f'
+        << (category ? 1 : 0) << '\x1f';
+    if (mtime_from) {
+      out << *mtime_from;
+    }
+    out << '\x1f';
+    if (mtime_to) {
+      out << *mtime_to;
+    }
+    for (const auto &label : labels) {
+      out << '\x1f' << label;
+    }
+    return out.str();
+  }
+
+  bool matchesLabels(const std::map<std::string, std::string> &container) const {
+    for (const auto &label : labels) {
+      const auto eq = label.find('=');
+      const auto key = label.substr(0, eq);
+      auto it = container.find(key);
+      if (it == container.end() ||
+          (eq != std::string::npos && it->second != label.substr(eq + 1))) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_SEARCH_FILTER
@@ -0,0 +1,42 @@
+#ifndef OWL_VFS_CORE_INDEX_SIMD_CPU
+#define OWL_VFS_CORE_INDEX_SIMD_CPU
+
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define OWL_SIMD_X86 1
+#endif
+
+namespace owl::simd {
+
+enum class Level { Scalar, Avx2, Avx512 };
+
+// Queried once; the kernels table is chosen from it at first use.
+inline Level detectLevel() {
+#if defined(OWL_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return Level::Avx512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return Level::Avx2;
+  }
+#endif
+  return Level::Scalar;
+}
+
+inline std::string_view levelName(Level level) {
+  switch (level) {
+  case Level::Avx512:
+    return "avx512";
+  case Level::Avx2:
+    return "avx2";
+  case Level::Scalar:
+    break;
+  }
+  return "scalar";
+}
+
+} // namespace owl::simd
+
+#endif // OWL_VFS_CORE_INDEX_SIMD_CPU
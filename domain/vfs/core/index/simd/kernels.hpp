@@ -0,0 +1,191 @@
+#ifndef OWL_VFS_CORE_INDEX_SIMD_KERNELS
+#define OWL_VFS_CORE_INDEX_SIMD_KERNELS
+
+#include <cstddef>
+
+#include "vfs/core/index/simd/cpu.hpp"
+
+#ifdef OWL_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace owl::simd {
+
+// Scoring kernels over contiguous float buffers. Each variant is compiled
+// with its own target attribute, so the AVX-512 path exists even though the
+// build only enables AVX2 globally, and kernels() picks one at runtime.
+struct Kernels {
+  Level level;
+  float (*dot)(const float *a, const float *b, std::size_t n);
+  // out[r] = <query, rows + r * dim> for r in [0, count).
+  void (*dotRows)(const float *query, const float *rows, std::size_t count,
+                  std::size_t dim, float *out);
+  // out[i] = wa * a[i] + wb * b[i].
+  void (*fuse)(const float *a, float wa, const float *b, float wb, float *out,
+               std::size_t n);
+};
+
+namespace detail {
+
+inline float dotScalar(const float *a, const float *b, std::size_t n) {
+  float s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    s0 += a[i] * b[i];
+    s1 += a[i + 1] * b[i + 1];
+    s2 += a[i + 2] * b[i + 2];
+    s3 += a[i + 3] * b[i + 3];
+  }
+  for (; i < n; ++i) {
+    s0 += a[i] * b[i];
+  }
+  return (s0 + s1) + (s2 + s3);
+}
+
+inline void dotRowsScalar(const float *query, const float *rows,
+                          std::size_t count, std::size_t dim, float *out) {
+  for (std::size_t r = 0; r < count; ++r) {
+    out[r] = dotScalar(query, rows + r * dim, dim);
+  }
+}
+
+inline void fuseScalar(const float *a, float wa, const float *b, float wb,
+                       float *out, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = wa * a[i] + wb * b[i];
+  }
+}
+
+#ifdef OWL_SIMD_X86
+
+__attribute__((target("avx2,fma"))) inline float
+dotAvx2(const float *a, const float *b, std::size_t n) {
+  __m256 acc0 = _mm256_setzero_ps();
+  __m256 acc1 = _mm256_setzero_ps();
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i),
+                           acc0);
+    acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8),
+                           _mm256_loadu_ps(b + i + 8), acc1);
+  }
+  for (; i + 8 <= n; i += 8) {
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i),
+                           acc0);
+  }
+
+  acc0 = _mm256_add_ps(acc0, acc1);
+  __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc0),
+                          _mm256_extractf128_ps(acc0, 1));
+  sum = _mm_hadd_ps(sum, sum);
+  sum = _mm_hadd_ps(sum, sum);
+
+  float s = _mm_cvtss_f32(sum);
+  for (; i < n; ++i) {
+    s += a[i] * b[i];
+  }
+  return s;
+}
+
+__attribute__((target("avx2,fma"))) inline void
+dotRowsAvx2(const float *query, const float *rows, std::size_t count,
+            std::size_t dim, float *out) {
+  for (std::size_t r = 0; r < count; ++r) {
+    out[r] = dotAvx2(query, rows + r * dim, dim);
+  }
+}
+
+__attribute__((target("avx2,fma"))) inline void
+fuseAvx2(const float *a, float wa, const float *b, float wb, float *out,
+         std::size_t n) {
+  const __m256 va = _mm256_set1_ps(wa);
+  const __m256 vb = _mm256_set1_ps(wb);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256 x = _mm256_mul_ps(_mm256_loadu_ps(a + i), va);
+    _mm256_storeu_ps(out + i,
+                     _mm256_fmadd_ps(_mm256_loadu_ps(b + i), vb, x));
+  }
+  for (; i < n; ++i) {
+    out[i] = wa * a[i] + wb * b[i];
+  }
+}
+
+__attribute__((target("avx512f"))) inline float
+dotAvx512(const float *a, const float *b, std::size_t n) {
+  __m512 acc0 = _mm512_setzero_ps();
+  __m512 acc1 = _mm512_setzero_ps();
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i),
+                           acc0);
+    acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16),
+                           _mm512_loadu_ps(b + i + 16), acc1);
+  }
+  for (; i + 16 <= n; i += 16) {
+    acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i),
+                           acc0);
+  }
+  if (i < n) {
+    const __mmask16 tail = static_cast<__mmask16>((1u << (n - i)) - 1);
+    acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, a + i),
+                           _mm512_maskz_loadu_ps(tail, b + i), acc1);
+  }
+  return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+}
+
+__attribute__((target("avx512f"))) inline void
+dotRowsAvx512(const float *query, const float *rows, std::size_t count,
+              std::size_t dim, float *out) {
+  for (std::size_t r = 0; r < count; ++r) {
+    out[r] = dotAvx512(query, rows + r * dim, dim);
+  }
+}
+
+__attribute__((target("avx512f"))) inline void
+fuseAvx512(const float *a, float wa, const float *b, float wb, float *out,
+           std::size_t n) {
+  const __m512 va = _mm512_set1_ps(wa);
+  const __m512 vb = _mm512_set1_ps(wb);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m512 x = _mm512_mul_ps(_mm512_loadu_ps(a + i), va);
+    _mm512_storeu_ps(out + i,
+                     _mm512_fmadd_ps(_mm512_loadu_ps(b + i), vb, x));
+  }
+  if (i < n) {
+    const __mmask16 tail = static_cast<__mmask16>((1u << (n - i)) - 1);
+    const __m512 x = _mm512_mul_ps(_mm512_maskz_loadu_ps(tail, a + i), va);
+    _mm512_mask_storeu_ps(
+        out + i, tail,
+        _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, b + i), vb, x));
+  }
+}
+
+#endif // OWL_SIMD_X86
+
+inline Kernels selectKernels(Level level) {
+#ifdef OWL_SIMD_X86
+  switch (level) {
+  case Level::Avx512:
+    return {Level::Avx512, dotAvx512, dotRowsAvx512, fuseAvx512};
+  case Level::Avx2:
+    return {Level::Avx2, dotAvx2, dotRowsAvx2, fuseAvx2};
+  case Level::Scalar:
+    break;
+  }
+#endif
+  (void)level;
+  return {Level::Scalar, dotScalar, dotRowsScalar, fuseScalar};
+}
+
+} // namespace detail
+
+inline const Kernels &kernels() {
+  static const Kernels selected = detail::selectKernels(detectLevel());
+  return selected;
+}
+
+} // namespace owl::simd
+
+#endif // OWL_VFS_CORE_INDEX_SIMD_KERNELS
@@ -0,0 +1,58 @@
+#ifndef OWL_VFS_CORE_INDEX_TOP_K
+#define OWL_VFS_CORE_INDEX_TOP_K
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace owl {
+
+// Bounded min-heap keeping the `capacity` highest-scoring items seen so far.
+// Merging n per-source top-k lists costs O(n k log k) and never holds more
+// than k candidates, however many sources report in.
+template <typename T> class TopK {
+public:
+  explicit TopK(std::size_t capacity) : capacity_(capacity) {
+    heap_.reserve(capacity);
+  }
+
+  void push(T item, float score) {
+    if (capacity_ == 0) {
+      return;
+    }
+    if (heap_.size() < capacity_) {
+      heap_.emplace_back(score, std::move(item));
+      std::push_heap(heap_.begin(), heap_.end(), kMinFirst);
+      return;
+    }
+    if (score <= heap_.front().first) {
+      return;
+    }
+
+    std::pop_heap(heap_.begin(), heap_.end(), kMinFirst);
+    heap_.back() = {score, std::move(item)};
+    std::push_heap(heap_.begin(), heap_.end(), kMinFirst);
+  }
+
+  std::size_t size() const { return heap_.size(); }
+
+  // Highest score first; leaves the heap empty.
+  std::vector<std::pair<float, T>> take() {
+    std::sort_heap(heap_.begin(), heap_.end(), kMinFirst);
+    return std::move(heap_);
+  }
+
+private:
+  static constexpr auto kMinFirst = [](const auto &a, const auto &b) {
+    return a.first > b.first;
+  };
+
+  std::size_t capacity_;
+  std::vector<std::pair<float, T>> heap_;
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_TOP_K
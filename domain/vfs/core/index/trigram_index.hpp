@@ -0,0 +1,271 @@
+#ifndef OWL_VFS_CORE_INDEX_TRIGRAM_INDEX
+#define OWL_VFS_CORE_INDEX_TRIGRAM_INDEX
+
+#include <fnmatch.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace owl {
+
+// Inverted index from path trigrams to the paths that contain them. Queries
+// intersect the posting lists of the pattern's trigrams and verify only the
+// surviving candidates, so the cost follows the result size rather than the
+// number of files in the container.
+class TrigramIndex {
+public:
+  using DocId = std::uint32_t;
+  using Trigram = std::uint32_t;
+
+  TrigramIndex() = default;
+
+  TrigramIndex(const TrigramIndex &) = delete;
+  TrigramIndex &operator=(const TrigramIndex &) = delete;
+
+  void add(std::string_view path) {
+    std::unique_lock lock(mutex_);
+
+    if (path.empty() || ids_.find(std::string(path)) != ids_.end()) {
+      return;
+    }
+
+    DocId id;
+    if (!free_ids_.empty()) {
+      id = free_ids_.back();
+      free_ids_.pop_back();
+      paths_[id] = std::string(path);
+    } else {
+      id = static_cast<DocId>(paths_.size());
+      paths_.emplace_back(path);
+    }
+    ids_.emplace(paths_[id], id);
+
+    for (const auto trigram : trigramsOf(path)) {
+      auto &posting = postings_[trigram];
+      posting.insert(std::lower_bound(posting.begin(), posting.end(), id), id);
+    }
+  }
+
+  void remove(std::string_view path) {
+    std::unique_lock lock(mutex_);
+
+    auto it = ids_.find(std::string(path));
+    if (it == ids_.end()) {
+      return;
+    }
+
+    const DocId id = it->second;
+    for (const auto trigram : trigramsOf(path)) {
+      auto posting_it = postings_.find(trigram);
+      if (posting_it == postings_.end()) {
+        continue;
+      }
+
+      auto &posting = posting_it->second;
+      auto pos = std::lower_bound(posting.begin(), posting.end(), id);
+      if (pos != posting.end() && *pos == id) {
+        posting.erase(pos);
+      }
+      if (posting.empty()) {
+        postings_.erase(posting_it);
+      }
+    }
+
+    ids_.erase(it);
+    paths_[id].clear();
+    free_ids_.push_back(id);
+  }
+
+  void clear() {
+    std::unique_lock lock(mutex_);
+    paths_.clear();
+    free_ids_.clear();
+    ids_.clear();
+    postings_.clear();
+  }
+
+  std::size_t size() const {
+    std::shared_lock lock(mutex_);
+    return ids_.size();
+  }
+
+  bool contains(std::string_view path) const {
+    std::shared_lock lock(mutex_);
+    return ids_.find(std::string(path)) != ids_.end();
+  }
+
+  std::vector<std::string> paths() const {
+    std::shared_lock lock(mutex_);
+    std::vector<std::string> out;
+    out.reserve(ids_.size());
+    for (const auto &[path, id] : ids_) {
+      out.push_back(path);
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+  }
+
+  static bool isGlob(std::string_view pattern) {
+    return pattern.find_first_of("*?[") != std::string_view::npos;
+  }
+
+  // Patterns without '/' are matched against the file name only, the same
+  // way the directory walk in searchFiles() used to behave.
+  std::vector<std::string> findSubstring(std::string_view pattern) const {
+    std::shared_lock lock(mutex_);
+
+    const bool whole_path = pattern.find('/') != std::string_view::npos;
+    return collect({pattern}, [&](std::string_view path) {
+      const auto target = whole_path ? path : fileName(path);
+      return target.find(pattern) != std::string_view::npos;
+    });
+  }
+
+  std::vector<std::string> findGlob(std::string_view pattern) const {
+    std::shared_lock lock(mutex_);
+
+    const bool whole_path = pattern.find('/') != std::string_view::npos;
+    const std::string glob(pattern);
+    return collect(literalRuns(pattern), [&](std::string_view path) {
+      const std::string target(whole_path ? path : fileName(path));
+      return fnmatch(glob.c_str(), target.c_str(), 0) == 0;
+    });
+  }
+
+  std::vector<std::string> find(std::string_view pattern) const {
+    return isGlob(pattern) ? findGlob(pattern) : findSubstring(pattern);
+  }
+
+private:
+  static std::string_view fileName(std::string_view path) {
+    const auto slash = path.rfind('/');
+    return slash == std::string_view::npos ? path : path.substr(slash + 1);
+  }
+
+  static Trigram pack(unsigned char a, unsigned char b, unsigned char c) {
+    return (static_cast<Trigram>(a) << 16) | (static_cast<Trigram>(b) << 8) |
+           static_cast<Trigram>(c);
+  }
+
+  static std::vector<Trigram> trigramsOf(std::string_view text) {
+    std::vector<Trigram> result;
+    if (text.size() < 3) {
+      return result;
+    }
+
+    result.reserve(text.size() - 2);
+    for (std::size_t i = 0; i + 2 < text.size(); ++i) {
+      result.push_back(pack(text[i], text[i + 1], text[i + 2]));
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+  }
+
+  // Literal stretches of a glob that every match must contain verbatim.
+  static std::vector<std::string_view> literalRuns(std::string_view glob) {
+    std::vector<std::string_view> runs;
+    std::size_t start = 0;
+
+    for (std::size_t i = 0; i < glob.size(); ++i) {
+      const char c = glob[i];
+      if (c != '*' && c != '?' && c != '[' && c != '\\') {
+        continue;
+      }
+
+      if (i > start) {
+        runs.push_back(glob.substr(start, i - start));
+      }
+
+      if (c == '[') {
+        const auto close = glob.find(']', i + 1);
+        i = close == std::string_view::npos ? glob.size() : close;
+      } else if (c == '\\') {
+        ++i;
+      }
+      start = i + 1;
+    }
+
+    if (start < glob.size()) {
+      runs.push_back(glob.substr(start));
+    }
+    return runs;
+  }
+
+  template <typename Matcher>
+  std::vector<std::string>
+  collect(const std::vector<std::string_view> &literals,
+          Matcher &&matches) const {
+    std::vector<const std::vector<DocId> *> lists;
+    bool indexed = false;
+
+    for (const auto literal : literals) {
+      for (const auto trigram : trigramsOf(literal)) {
+        auto it = postings_.find(trigram);
+        if (it == postings_.end()) {
+          return {};
+        }
+        lists.push_back(&it->second);
+        indexed = true;
+      }
+    }
+
+    std::vector<std::string> results;
+
+    if (!indexed) {
+      for (const auto &[path, id] : ids_) {
+        if (matches(path)) {
+          results.push_back(path);
+        }
+      }
+      std::sort(results.begin(), results.end());
+      return results;
+    }
+
+    std::sort(lists.begin(), lists.end(),
+              [](const auto *a, const auto *b) { return a->size() < b->size(); });
+
+    std::vector<DocId> candidates = *lists.front();
+    for (std::size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+      const auto &posting = *lists[i];
+      auto from = posting.begin();
+
+      std::size_t kept = 0;
+      for (const auto id : candidates) {
+        from = std::lower_bound(from, posting.end(), id);
+        if (from == posting.end()) {
+          break;
+        }
+        if (*from == id) {
+          candidates[kept++] = id;
+        }
+      }
+      candidates.resize(kept);
+    }
+
+    for (const auto id : candidates) {
+      if (matches(paths_[id])) {
+        results.push_back(paths_[id]);
+      }
+    }
+    std::sort(results.begin(), results.end());
+    return results;
+  }
+
+  mutable std::shared_mutex mutex_;
+  std::vector<std::string> paths_;
+  std::vector<DocId> free_ids_;
+  std::unordered_map<std::string, DocId> ids_;
+  std::unordered_map<Trigram, std::vector<DocId>> postings_;
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_TRIGRAM_INDEX
@@ -0,0 +1,638 @@
+#ifndef OWL_VFS_CORE_INDEX_VECTOR_INDEX
+#define OWL_VFS_CORE_INDEX_VECTOR_INDEX
+
+#include <faiss/IndexFlat.h>
+#include <faiss/IndexHNSW.h>
+#include <faiss/IndexIDMap.h>
+#include <faiss/IndexIVF.h>
+#include <faiss/clone_index.h>
+#include <faiss/impl/IDSelector.h>
+#include <faiss/index_factory.h>
+#include <faiss/index_io.h>
+#include <faiss/utils/distances.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <infrastructure/result.hpp>
+
+#include "vfs/core/index/index_config.hpp"
+#include "vfs/core/index/search_filter.hpp"
+#include "vfs/core/index/simd/kernels.hpp"
+
+namespace owl {
+
+namespace fs = std::filesystem;
+
+// Recall@10 of a compressed index against exact search over the same vectors,
+// for the raw index results and after re-ranking the over-fetched candidates
+// with the exact vectors.
+struct RecallReport {
+  float raw = 0;
+  float reranked = 0;
+  std::size_t queries = 0;
+};
+
+// Owl-owned per-file vector index (cosine via inner product on normalised
+// vectors). Unlike the chunkees index it can be written to and loaded from
+// `<data_path>/.owl/`, which is what lets a container come up without
+// re-embedding everything. The underlying faiss index is built from a factory
+// string ("Flat", "HNSW32", "SQ8", "HNSW32_SQfp16", "IVF4096,PQ60", ...);
+// trained and quantised types are only produced by build(). FileMeta is kept
+// in id-indexed columns, which is what lets a SearchFilter be compiled into a
+// bitmap and evaluated inside the faiss search. Not synchronised; VersionedVectorIndex only mutates
+// copies that no reader can see yet.
+class VectorIndex {
+public:
+  using Error = std::runtime_error;
+  using Id = faiss::idx_t;
+  using Hits = std::vector<std::pair<std::string, float>>;
+
+  static constexpr const char *kIndexFile = "vectors.faiss";
+  static constexpr const char *kPathsFile = "vectors.paths";
+
+  static constexpr std::size_t kMaxTrainingVectors = 200'000;
+  static constexpr std::size_t kRecallQueries = 32;
+  static constexpr std::size_t kRecallDepth = 10;
+
+  explicit VectorIndex(std::size_t dimension)
+      : dimension_(dimension),
+        index_(std::make_unique<faiss::IndexIDMap2>(
+            new faiss::IndexFlatIP(static_cast<faiss::idx_t>(dimension)))) {
+    index_->own_fields = true;
+  }
+
+  // Builds (and trains, if the type needs it) an index of type `factory`
+  // holding `items`.
+  static core::Result<std::shared_ptr<VectorIndex>>
+  build(std::size_t dimension, const std::string &factory,
+        const std::vector<std::pair<std::string, std::vector<float>>> &items,
+        const IndexConfig &config = {}) {
+    try {
+      if (factory == "Flat") {
+        auto index = std::make_shared<VectorIndex>(dimension);
+        for (const auto &[path, vector] : items) {
+          index->upsert(path, vector);
+        }
+        return core::Result<std::shared_ptr<VectorIndex>, Error>::Ok(
+            std::move(index));
+      }
+
+      auto index = std::shared_ptr<VectorIndex>(new VectorIndex(dimension, 0));
+      index->factory_ = factory;
+      index->index_ = std::make_unique<faiss::IndexIDMap2>(faiss::index_factory(
+          static_cast<int>(dimension), factory.c_str(),
+          faiss::METRIC_INNER_PRODUCT));
+      index->index_->own_fields = true;
+
+      std::vector<float> matrix;
+      matrix.reserve(items.size() * dimension);
+      for (const auto &[path, vector] : items) {
+        matrix.insert(matrix.end(), vector.begin(), vector.end());
+      }
+      faiss::fvec_renorm_L2(dimension, items.size(), matrix.data());
+
+      if (!index->index_->is_trained) {
+        // Evenly spaced sample, so training cost is bounded for huge corpora.
+        const auto stride =
+            std::max<std::size_t>(1, items.size() / kMaxTrainingVectors);
+        std::vector<float> sample;
+        for (std::size_t i = 0; i < items.size(); i += stride) {
+          sample.insert(sample.end(), matrix.begin() + i * dimension,
+                        matrix.begin() + (i + 1) * dimension);
+        }
+        index->index_->train(
+            static_cast<faiss::idx_t>(sample.size() / dimension),
+            sample.data());
+      }
+      index->applyDefaults(config.defaults());
+
+      std::vector<Id> ids(items.size());
+      for (std::size_t i = 0; i < items.size(); ++i) {
+        ids[i] = index->next_id_++;
+        index->ids_.emplace(items[i].first, ids[i]);
+        index->paths_.emplace(ids[i], items[i].first);
+      }
+      index->index_->add_with_ids(static_cast<faiss::idx_t>(items.size()),
+                                  matrix.data(), ids.data());
+      if (!index->exact()) {
+        index->recall_ = index->measureRecall(matrix);
+      }
+
+      return core::Result<std::shared_ptr<VectorIndex>, Error>::Ok(
+          std::move(index));
+    } catch (const std::exception &e) {
+      return core::Result<std::shared_ptr<VectorIndex>, Error>::Error(
+          Error("failed to build " + factory + " index: " + e.what()));
+    }
+  }
+
+  std::size_t dimension() const { return dimension_; }
+  std::size_t size() const { return ids_.size(); }
+  // Removed vectors an HNSW graph still holds; searches over-fetch by these.
+  std::size_t tombstones() const { return tombstones_; }
+  const std::string &factory() const { return factory_; }
+  IndexFamily family() const { return indexFamily(factory_); }
+
+  // False for quantised types, whose stored vectors are approximations.
+  bool exact() const { return exactFactory(factory_); }
+
+  // Measured when a compressed index is built; empty otherwise.
+  const std::optional<RecallReport> &recall() const { return recall_; }
+
+  bool contains(const std::string &path) const {
+    return ids_.find(path) != ids_.end();
+  }
+
+  std::vector<std::string> paths() const {
+    std::vector<std::string> out;
+    out.reserve(ids_.size());
+    for (const auto &[path, id] : ids_) {
+      out.push_back(path);
+    }
+    return out;
+  }
+
+  std::shared_ptr<VectorIndex> clone() const {
+    auto copy = std::shared_ptr<VectorIndex>(new VectorIndex(dimension_, 0));
+    copy->index_.reset(
+        dynamic_cast<faiss::IndexIDMap2 *>(faiss::clone_index(index_.get())));
+    copy->ids_ = ids_;
+    copy->paths_ = paths_;
+    copy->next_id_ = next_id_;
+    copy->tombstones_ = tombstones_;
+    copy->factory_ = factory_;
+    copy->recall_ = recall_;
+    copy->mtimes_ = mtimes_;
+    copy->categories_ = categories_;
+    copy->category_names_ = category_names_;
+    return copy;
+  }
+
+  // Visits every stored (already normalised) vector. Quantised types yield
+  // their decoded approximations and IVF types are not supported at all.
+  template <typename Visitor> void forEach(Visitor &&visit) const {
+    std::vector<float> buffer(dimension_);
+    for (const auto &[path, id] : ids_) {
+      index_->reconstruct(id, buffer.data());
+      visit(path, buffer);
+    }
+  }
+
+  // Copies the stored (normalised) vector for `path` into `out`. Quantised
+  // types only hold approximations and always return false.
+  bool reconstruct(const std::string &path, float *out) const {
+    auto it = ids_.find(path);
+    if (it == ids_.end() || !exact()) {
+      return false;
+    }
+    index_->reconstruct(it->second, out);
+    return true;
+  }
+
+  std::optional<FileMeta> meta(const std::string &path) const {
+    auto it = ids_.find(path);
+    if (it == ids_.end()) {
+      return std::nullopt;
+    }
+    const auto id = static_cast<std::size_t>(it->second);
+    FileMeta out;
+    if (id < mtimes_.size()) {
+      out.mtime = mtimes_[id];
+      out.category = category_names_[categories_[id]];
+    }
+    return out;
+  }
+
+  bool annotate(const std::string &path, const FileMeta &meta) {
+    auto it = ids_.find(path);
+    if (it == ids_.end()) {
+      return false;
+    }
+    setMeta(it->second, meta);
+    return true;
+  }
+
+  core::Result<void> upsert(const std::string &path, std::vector<float> vector,
+                            const FileMeta &meta = {}) {
+    if (vector.size() != dimension_) {
+      return core::Result<void, Error>::Error(
+          Error("vector dimension mismatch for " + path));
+    }
+
+    remove(path);
+    faiss::fvec_renorm_L2(dimension_, 1, vector.data());
+
+    const Id id = next_id_++;
+    index_->add_with_ids(1, vector.data(), &id);
+    ids_.emplace(path, id);
+    paths_.emplace(id, path);
+    setMeta(id, meta);
+    return core::Result<void, Error>::Ok();
+  }
+
+  bool remove(const std::string &path) {
+    auto it = ids_.find(path);
+    if (it == ids_.end()) {
+      return false;
+    }
+
+    const Id id = it->second;
+    if (family() == IndexFamily::Hnsw) {
+      // HNSW graphs cannot drop nodes; the vector stays until the next build.
+      ++tombstones_;
+    } else {
+      faiss::IDSelectorBatch selector(1, &id);
+      index_->remove_ids(selector);
+    }
+    paths_.erase(id);
+    ids_.erase(it);
+    return true;
+  }
+
+  // A non-empty `filter` is compiled into an id bitmap that faiss consults
+  // while it searches, so the k results are k matching files rather than
+  // whatever survives filtering the unfiltered top k.
+  Hits search(std::vector<float> query, std::size_t k,
+              const VectorSearchParams &tuning = {},
+              const SearchFilter &filter = {}) const {
+    if (query.size() != dimension_ || ids_.empty() || k == 0) {
+      return {};
+    }
+
+    faiss::fvec_renorm_L2(dimension_, 1, query.data());
+    const auto wanted = std::min(k, ids_.size());
+    k = wanted + tombstones_;
+
+    std::vector<float> distances(k);
+    std::vector<Id> labels(k);
+    const auto bitmap = compile(filter);
+    faiss::IDSelectorBitmap selector(bitmap.size(), bitmap.data());
+    const auto params =
+        searchParameters(tuning, filter.empty() ? nullptr : &selector);
+    index_->search(1, query.data(), static_cast<faiss::idx_t>(k),
+                   distances.data(), labels.data(), params.get());
+
+    Hits hits;
+    hits.reserve(k);
+    for (std::size_t i = 0; i < k && hits.size() < wanted; ++i) {
+      auto it = paths_.find(labels[i]);
+      if (labels[i] >= 0 && it != paths_.end()) {
+        hits.emplace_back(it->second, distances[i]);
+      }
+    }
+    return hits;
+  }
+
+  // One matrix search for all queries, so faiss can use its batched BLAS path
+  // instead of n separate scans. Queries of the wrong dimension get no hits.
+  std::vector<Hits> searchBatch(std::vector<std::vector<float>> queries,
+                                std::size_t k,
+                                const VectorSearchParams &tuning = {},
+                                const SearchFilter &filter = {}) const {
+    std::vector<Hits> out(queries.size());
+    const auto wanted = std::min(k, ids_.size());
+    if (wanted == 0) {
+      return out;
+    }
+    k = wanted + tombstones_;
+
+    std::vector<std::size_t> slots;
+    std::vector<float> matrix;
+    matrix.reserve(queries.size() * dimension_);
+    for (std::size_t i = 0; i < queries.size(); ++i) {
+      if (queries[i].size() != dimension_) {
+        continue;
+      }
+      slots.push_back(i);
+      matrix.insert(matrix.end(), queries[i].begin(), queries[i].end());
+    }
+    if (slots.empty()) {
+      return out;
+    }
+
+    const auto n = slots.size();
+    faiss::fvec_renorm_L2(dimension_, n, matrix.data());
+
+    std::vector<float> distances(n * k);
+    std::vector<Id> labels(n * k);
+    const auto bitmap = compile(filter);
+    faiss::IDSelectorBitmap selector(bitmap.size(), bitmap.data());
+    const auto params =
+        searchParameters(tuning, filter.empty() ? nullptr : &selector);
+    index_->search(static_cast<faiss::idx_t>(n), matrix.data(),
+                   static_cast<faiss::idx_t>(k), distances.data(),
+                   labels.data(), params.get());
+
+    for (std::size_t q = 0; q < n; ++q) {
+      auto &hits = out[slots[q]];
+      hits.reserve(wanted);
+      for (std::size_t j = q * k; j < (q + 1) * k && hits.size() < wanted;
+           ++j) {
+        auto it = paths_.find(labels[j]);
+        if (labels[j] >= 0 && it != paths_.end()) {
+          hits.emplace_back(it->second, distances[j]);
+        }
+      }
+    }
+    return out;
+  }
+
+  // Written to temporaries and renamed into place, so a crash mid-save keeps
+  // the previous snapshot.
+  core::Result<void> save(const fs::path &dir) const {
+    try {
+      fs::create_directories(dir);
+
+      const auto index_tmp = dir / (std::string(kIndexFile) + ".tmp");
+      const auto paths_tmp = dir / (std::string(kPathsFile) + ".tmp");
+
+      faiss::write_index(index_.get(), index_tmp.c_str());
+
+      std::ofstream out(paths_tmp, std::ios::trunc);
+      out << dimension_ << '\t' << next_id_ << '\t' << factory_ << '\t'
+          << kColumnsTag << '\n';
+      for (const auto &[id, path] : paths_) {
+        const auto meta = this->meta(path);
+        out << id << '\t' << meta->mtime << '\t' << meta->category << '\t'
+            << path << '\n';
+      }
+      out.close();
+      if (!out) {
+        return core::Result<void, Error>::Error(
+            Error("failed to write " + paths_tmp.string()));
+      }
+
+      fs::rename(index_tmp, dir / kIndexFile);
+      fs::rename(paths_tmp, dir / kPathsFile);
+      return core::Result<void, Error>::Ok();
+    } catch (const std::exception &e) {
+      return core::Result<void, Error>::Error(
+          Error(std::string("vector index save failed: ") + e.what()));
+    }
+  }
+
+  static core::Result<std::shared_ptr<VectorIndex>> load(const fs::path &dir) {
+    try {
+      std::ifstream in(dir / kPathsFile);
+      if (!in || !fs::exists(dir / kIndexFile)) {
+        return core::Result<std::shared_ptr<VectorIndex>, Error>::Error(
+            Error("no vector index snapshot in " + dir.string()));
+      }
+
+      std::size_t dimension = 0;
+      Id next_id = 0;
+      std::string factory;
+      in >> dimension >> next_id;
+      std::getline(in, factory);
+      factory.erase(0, factory.find_first_not_of(" \t"));
+
+      // Snapshots written before metadata columns existed have bare
+      // "id<TAB>path" rows.
+      bool columns = false;
+      if (const auto tab = factory.find('\t'); tab != std::string::npos) {
+        columns = factory.substr(tab + 1) == kColumnsTag;
+        factory.resize(tab);
+      }
+
+      std::unique_ptr<faiss::Index> raw(
+          faiss::read_index((dir / kIndexFile).c_str()));
+      auto *mapped = dynamic_cast<faiss::IndexIDMap2 *>(raw.get());
+      if (!mapped || static_cast<std::size_t>(mapped->d) != dimension) {
+        return core::Result<std::shared_ptr<VectorIndex>, Error>::Error(
+            Error("unexpected vector index layout in " + dir.string()));
+      }
+
+      auto index = std::shared_ptr<VectorIndex>(new VectorIndex(dimension, 0));
+      raw.release();
+      index->index_.reset(mapped);
+      index->next_id_ = next_id;
+      if (!factory.empty()) {
+        index->factory_ = std::move(factory);
+      }
+
+      std::string line;
+      while (std::getline(in, line)) {
+        auto tab = line.find('\t');
+        if (tab == std::string::npos) {
+          continue;
+        }
+        const Id id = std::stoll(line.substr(0, tab));
+
+        FileMeta meta;
+        if (columns) {
+          const auto second = line.find('\t', tab + 1);
+          const auto third = line.find('\t', second + 1);
+          if (second == std::string::npos || third == std::string::npos) {
+            continue;
+          }
+          meta.mtime = std::stoll(line.substr(tab + 1, second - tab - 1));
+          meta.category = line.substr(second + 1, third - second - 1);
+          tab = third;
+        }
+
+        auto path = line.substr(tab + 1);
+        index->ids_.emplace(path, id);
+        index->paths_.emplace(id, std::move(path));
+        index->setMeta(id, meta);
+      }
+      index->tombstones_ =
+          static_cast<std::size_t>(mapped->ntotal) - index->ids_.size();
+
+      return core::Result<std::shared_ptr<VectorIndex>, Error>::Ok(
+          std::move(index));
+    } catch (const std::exception &e) {
+      return core::Result<std::shared_ptr<VectorIndex>, Error>::Error(
+          Error(std::string("vector index load failed: ") + e.what()));
+    }
+  }
+
+  static fs::file_time_type snapshotTime(const fs::path &dir) {
+    std::error_code ec;
+    auto time = fs::last_write_time(dir / kPathsFile, ec);
+    return ec ? fs::file_time_type::min() : time;
+  }
+
+private:
+  VectorIndex(std::size_t dimension, int) : dimension_(dimension) {}
+
+  static constexpr const char *kColumnsTag = "columns";
+
+  void setMeta(Id id, const FileMeta &meta) {
+    const auto slot = static_cast<std::size_t>(id);
+    if (slot >= mtimes_.size()) {
+      mtimes_.resize(slot + 1, 0);
+      categories_.resize(slot + 1, 0);
+    }
+    mtimes_[slot] = meta.mtime;
+
+    auto it = std::find(category_names_.begin(), category_names_.end(),
+                        meta.category);
+    if (it == category_names_.end()) {
+      it = category_names_.insert(category_names_.end(), meta.category);
+    }
+    categories_[slot] =
+        static_cast<std::uint32_t>(it - category_names_.begin());
+  }
+
+  // One bit per id; set for live ids that pass `filter`. Only the category
+  // dictionary lookup touches strings besides the path prefix test.
+  std::vector<std::uint8_t> compile(const SearchFilter &filter) const {
+    if (filter.empty()) {
+      return {};
+    }
+
+    std::vector<std::uint8_t> bitmap((static_cast<std::size_t>(next_id_) + 7) /
+                                     8);
+    std::optional<std::uint32_t> code;
+    if (filter.category) {
+      auto it = std::find(category_names_.begin(), category_names_.end(),
+                          *filter.category);
+      if (it == category_names_.end()) {
+        return bitmap;
+      }
+      code = static_cast<std::uint32_t>(it - category_names_.begin());
+    }
+
+    for (const auto &[id, path] : paths_) {
+      const auto slot = static_cast<std::size_t>(id);
+      if (!filter.matchesPath(path) ||
+          (code && categories_[slot] != *code) ||
+          (filter.mtime_from && mtimes_[slot] < *filter.mtime_from) ||
+          (filter.mtime_to && mtimes_[slot] > *filter.mtime_to)) {
+        continue;
+      }
+      bitmap[slot >> 3] |= static_cast<std::uint8_t>(1u << (slot & 7));
+    }
+    return bitmap;
+  }
+
+  std::unique_ptr<faiss::SearchParameters>
+  searchParameters(const VectorSearchParams &tuning,
+                   faiss::IDSelector *selector = nullptr) const {
+    std::unique_ptr<faiss::SearchParameters> params;
+    if (dynamic_cast<const faiss::IndexIVF *>(index_->index) &&
+        (tuning.nprobe > 0 || selector)) {
+      auto ivf = std::make_unique<faiss::SearchParametersIVF>();
+      ivf->nprobe = tuning.nprobe > 0
+                        ? static_cast<std::size_t>(tuning.nprobe)
+                        : dynamic_cast<const faiss::IndexIVF *>(index_->index)
+                              ->nprobe;
+      params = std::move(ivf);
+    } else if (dynamic_cast<const faiss::IndexHNSW *>(index_->index) &&
+               (tuning.ef_search > 0 || selector)) {
+      auto hnsw = std::make_unique<faiss::SearchParametersHNSW>();
+      hnsw->efSearch =
+          tuning.ef_search > 0
+              ? tuning.ef_search
+              : dynamic_cast<const faiss::IndexHNSW *>(index_->index)
+                    ->hnsw.efSearch;
+      params = std::move(hnsw);
+    } else if (selector) {
+      params = std::make_unique<faiss::SearchParameters>();
+    }
+
+    if (params) {
+      params->sel = selector;
+    }
+    return params;
+  }
+
+  // Samples evenly spaced stored vectors as queries and compares the index's
+  // top kRecallDepth with brute force over `matrix` (row i holds id i).
+  RecallReport measureRecall(const std::vector<float> &matrix) const {
+    const auto count = matrix.size() / dimension_;
+    const auto depth = std::min(kRecallDepth, count);
+    const auto fetch = std::min(depth * IndexConfig::kRerankFactor, count);
+    if (depth == 0) {
+      return {};
+    }
+
+    const auto queries = std::min(kRecallQueries, count);
+    const auto &simd = simd::kernels();
+    std::vector<float> exact(count);
+    std::vector<float> distances(fetch);
+    std::vector<Id> labels(fetch);
+
+    RecallReport report;
+    report.queries = queries;
+    std::size_t raw = 0;
+    std::size_t reranked = 0;
+    for (std::size_t q = 0; q < queries; ++q) {
+      const float *query = matrix.data() + (q * count / queries) * dimension_;
+      simd.dotRows(query, matrix.data(), count, dimension_, exact.data());
+
+      std::vector<Id> truth(count);
+      for (std::size_t i = 0; i < count; ++i) {
+        truth[i] = static_cast<Id>(i);
+      }
+      std::partial_sort(
+          truth.begin(), truth.begin() + depth, truth.end(),
+          [&](Id a, Id b) { return exact[a] > exact[b]; });
+      truth.resize(depth);
+      std::sort(truth.begin(), truth.end());
+
+      index_->search(1, query, static_cast<faiss::idx_t>(fetch),
+                     distances.data(), labels.data());
+      const auto found = [&](Id id) {
+        return std::binary_search(truth.begin(), truth.end(), id);
+      };
+
+      std::vector<Id> candidates;
+      for (std::size_t i = 0; i < fetch; ++i) {
+        if (labels[i] < 0) {
+          continue;
+        }
+        if (i < depth && found(labels[i])) {
+          ++raw;
+        }
+        candidates.push_back(labels[i]);
+      }
+
+      const auto top = std::min(depth, candidates.size());
+      std::partial_sort(
+          candidates.begin(), candidates.begin() + top, candidates.end(),
+          [&](Id a, Id b) { return exact[a] > exact[b]; });
+      reranked += std::count_if(candidates.begin(), candidates.begin() + top,
+                                found);
+    }
+
+    const auto total = static_cast<float>(queries * depth);
+    report.raw = raw / total;
+    report.reranked = reranked / total;
+    return report;
+  }
+
+  void applyDefaults(const VectorSearchParams &defaults) {
+    if (auto *ivf = dynamic_cast<faiss::IndexIVF *>(index_->index)) {
+      ivf->nprobe = static_cast<std::size_t>(std::max(defaults.nprobe, 1));
+    } else if (auto *hnsw = dynamic_cast<faiss::IndexHNSW *>(index_->index)) {
+      hnsw->hnsw.efSearch = std::max(defaults.ef_search, 16);
+    }
+  }
+
+  std::size_t dimension_;
+  std::unique_ptr<faiss::IndexIDMap2> index_;
+  std::unordered_map<std::string, Id> ids_;
+  std::unordered_map<Id, std::string> paths_;
+  Id next_id_ = 0;
+  std::size_t tombstones_ = 0;
+  std::string factory_ = "Flat";
+  std::optional<RecallReport> recall_;
+  std::vector<std::int64_t> mtimes_;
+  std::vector<std::uint32_t> categories_;
+  std::vector<std::string> category_names_{""};
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_VECTOR_INDEX
@@ -0,0 +1,736 @@
+#ifndef OWL_VFS_CORE_INDEX_VERSIONED_VECTOR_INDEX
+#define OWL_VFS_CORE_INDEX_VERSIONED_VECTOR_INDEX
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "vfs/core/index/exact_store.hpp"
+#include "vfs/core/index/index_config.hpp"
+#include "vfs/core/index/simd/kernels.hpp"
+#include "vfs/core/index/vector_index.hpp"
+
+namespace owl {
+
+// Immutable view of a container's vectors: a large shared base, a small delta
+// holding recent upserts, and the base paths shadowed by the delta or removed.
+// Once published a snapshot is never modified, so any number of queries can
+// run against it without locks while a writer prepares the next one. The one
+// shared mutable piece is the on-disk exact store, which only ever holds the
+// newest vector for a path.
+class VectorSnapshot {
+public:
+  using Hits = VectorIndex::Hits;
+  using PathSet = std::unordered_set<std::string>;
+
+  std::uint64_t generation() const { return generation_; }
+
+  std::size_t dimension() const { return base_ ? base_->dimension() : 0; }
+
+  std::string factory() const { return base_ ? base_->factory() : "Flat"; }
+
+  std::optional<RecallReport> recall() const {
+    return base_ ? base_->recall() : std::nullopt;
+  }
+
+  // Whether base candidates are re-scored against full-precision vectors.
+  bool reranked() const { return base_ && exact_ && !base_->exact(); }
+
+  // Dead vectors still held by an HNSW base.
+  std::size_t tombstones() const { return base_ ? base_->tombstones() : 0; }
+
+  // Full-precision vectors held on disk for re-ranking and rebuilds.
+  std::size_t exactSize() const { return exact_ ? exact_->size() : 0; }
+
+  std::size_t size() const {
+    if (!base_) {
+      return 0;
+    }
+    return base_->size() - removed_->size() + delta_->size();
+  }
+
+  bool contains(const std::string &path) const {
+    return base_ && (delta_->contains(path) ||
+                     (base_->contains(path) && !removed_->count(path)));
+  }
+
+  std::vector<std::string> paths() const {
+    if (!base_) {
+      return {};
+    }
+
+    auto out = delta_->paths();
+    for (auto &path : base_->paths()) {
+      if (!removed_->count(path)) {
+        out.push_back(std::move(path));
+      }
+    }
+    return out;
+  }
+
+  // Copies the vector for `path` into `out` (dimension() floats).
+  bool reconstruct(const std::string &path, float *out) const {
+    if (!base_) {
+      return false;
+    }
+    if (delta_->contains(path)) {
+      return delta_->reconstruct(path, out);
+    }
+    if (!base_->contains(path) || removed_->count(path)) {
+      return false;
+    }
+    return base_->reconstruct(path, out) || (exact_ && exact_->read(path, out));
+  }
+
+  std::optional<FileMeta> meta(const std::string &path) const {
+    if (!base_) {
+      return std::nullopt;
+    }
+    if (delta_->contains(path)) {
+      return delta_->meta(path);
+    }
+    return removed_->count(path) ? std::nullopt : base_->meta(path);
+  }
+
+  // For post-filtering candidates that did not come from this index.
+  bool matches(const std::string &path, const SearchFilter &filter) const {
+    if (filter.empty()) {
+      return true;
+    }
+    const auto found = filter.perFileMeta() ? meta(path) : std::nullopt;
+    return filter.matches(path, found ? &*found : nullptr);
+  }
+
+  // Zero fields in `tuning` fall back to the container's configured defaults.
+  Hits search(const std::vector<float> &query, std::size_t k,
+              const VectorSearchParams &tuning = {},
+              const SearchFilter &filter = {}) const {
+    if (!base_ || k == 0) {
+      return {};
+    }
+    auto hits = base_->search(query, fetchSize(k), resolve(tuning), filter);
+    if (reranked()) {
+      hits = rescore(query, std::move(hits));
+    }
+    return merge(std::move(hits), delta_->search(query, k, {}, filter), k);
+  }
+
+  std::vector<Hits> searchBatch(const std::vector<std::vector<float>> &queries,
+                                std::size_t k,
+                                const VectorSearchParams &tuning = {},
+                                const SearchFilter &filter = {}) const {
+    if (!base_ || k == 0) {
+      return std::vector<Hits>(queries.size());
+    }
+
+    auto base =
+        base_->searchBatch(queries, fetchSize(k), resolve(tuning), filter);
+    auto recent = delta_->searchBatch(queries, k, {}, filter);
+    for (std::size_t i = 0; i < base.size(); ++i) {
+      if (reranked()) {
+        base[i] = rescore(queries[i], std::move(base[i]));
+      }
+      base[i] = merge(std::move(base[i]), std::move(recent[i]), k);
+    }
+    return base;
+  }
+
+private:
+  friend class VersionedVectorIndex;
+
+  VectorSearchParams resolve(VectorSearchParams tuning) const {
+    if (tuning.nprobe <= 0) {
+      tuning.nprobe = defaults_.nprobe;
+    }
+    if (tuning.ef_search <= 0) {
+      tuning.ef_search = defaults_.ef_search;
+    }
+    return tuning;
+  }
+
+  std::size_t fetchSize(std::size_t k) const {
+    return (reranked() ? k * IndexConfig::kRerankFactor : k) +
+           removed_->size();
+  }
+
+  // Replaces the quantised scores of base candidates with exact cosines.
+  // Candidates missing from the exact store keep their approximate score.
+  Hits rescore(std::vector<float> query, Hits hits) const {
+    const auto dim = base_->dimension();
+    if (hits.empty() || query.size() != dim) {
+      return hits;
+    }
+
+    const auto &simd = simd::kernels();
+    const float norm = std::sqrt(simd.dot(query.data(), query.data(), dim));
+    if (norm > 0) {
+      for (auto &value : query) {
+        value /= norm;
+      }
+    }
+
+    std::vector<float> rows(hits.size() * dim);
+    std::vector<unsigned char> found(hits.size());
+    for (std::size_t i = 0; i < hits.size(); ++i) {
+      found[i] = exact_->read(hits[i].first, rows.data() + i * dim);
+    }
+
+    std::vector<float> scores(hits.size());
+    simd.dotRows(query.data(), rows.data(), hits.size(), dim, scores.data());
+    for (std::size_t i = 0; i < hits.size(); ++i) {
+      if (found[i]) {
+        hits[i].second = scores[i];
+      }
+    }
+    return hits;
+  }
+
+  Hits merge(Hits hits, Hits recent, std::size_t k) const {
+    hits.erase(std::remove_if(hits.begin(), hits.end(),
+                              [&](const auto &hit) {
+                                return removed_->count(hit.first) > 0;
+                              }),
+               hits.end());
+    hits.insert(hits.end(), std::make_move_iterator(recent.begin()),
+                std::make_move_iterator(recent.end()));
+
+    const auto top = std::min(k, hits.size());
+    std::partial_sort(
+        hits.begin(), hits.begin() + top, hits.end(),
+        [](const auto &a, const auto &b) { return a.second > b.second; });
+    hits.resize(top);
+    return hits;
+  }
+
+  std::shared_ptr<const VectorIndex> base_;
+  std::shared_ptr<const VectorIndex> delta_;
+  std::shared_ptr<const PathSet> removed_;
+  std::shared_ptr<const ExactVectorStore> exact_;
+  VectorSearchParams defaults_;
+  std::uint64_t generation_ = 0;
+};
+
+// RCU-style owner of the vector snapshots. Readers call snapshot() and keep
+// the returned pointer for as long as they need it. Writers are serialised,
+// copy only the small delta and removal set, and publish the result with a
+// single atomic store; once the two together grow past kMergeThreshold they
+// are folded into a fresh base, still off to the side of any reader. The
+// merge is also where the base is found to need rebuilding, either as the
+// index type IndexConfig asks for once the corpus crosses a size threshold or
+// to drop HNSW tombstones. Rebuilds train on a background thread from the
+// snapshot of the moment, so writers never wait for them; the writer lock is
+// only taken again to swap the new base in, with the paths written in the
+// meantime replayed into its delta. Once attached to a state directory every
+// upsert is also written to an ExactVectorStore, which feeds both the
+// re-ranking of quantised bases and the rebuilds.
+class VersionedVectorIndex {
+public:
+  using Error = std::runtime_error;
+  using Snapshot = std::shared_ptr<const VectorSnapshot>;
+
+  static constexpr std::size_t kMergeThreshold = 1024;
+  static constexpr double kMaxTombstoneRatio = 0.2;
+
+  VersionedVectorIndex() : current_(std::make_shared<const VectorSnapshot>()) {}
+
+  // Waits for a running rebuild; its result is still swapped in.
+  ~VersionedVectorIndex() {
+    if (rebuild_.joinable()) {
+      rebuild_.join();
+    }
+  }
+
+  VersionedVectorIndex(const VersionedVectorIndex &) = delete;
+  VersionedVectorIndex &operator=(const VersionedVectorIndex &) = delete;
+
+  Snapshot snapshot() const { return current_.load(std::memory_order_acquire); }
+
+  std::uint64_t generation() const { return snapshot()->generation(); }
+
+  // Blocks until no rebuild is running and the last one has been swapped in.
+  void awaitRebuild() {
+    std::unique_lock lock(writer_);
+    rebuilt_.wait(lock, [this] { return !touched_; });
+  }
+
+  void configure(IndexConfig config) {
+    std::lock_guard lock(writer_);
+    config_ = std::move(config);
+  }
+
+  // Opens (or creates) the exact vector store in `dir`. Without it quantised
+  // bases are searched on their codes alone.
+  core::Result<void> attach(const fs::path &dir) {
+    auto opened = ExactVectorStore::open(dir);
+    if (!opened.is_ok()) {
+      return core::Result<void, Error>::Error(opened.error());
+    }
+
+    std::lock_guard lock(writer_);
+    exact_ = std::move(opened.value());
+    const auto current = snapshot();
+    if (!current->base_) {
+      return core::Result<void, Error>::Ok();
+    }
+
+    // Snapshots written before the store existed are backfilled, as long as
+    // the base still holds full-precision vectors.
+    std::vector<float> buffer(current->dimension());
+    for (const auto &path : current->paths()) {
+      if (!exact_->contains(path) && current->reconstruct(path, buffer.data())) {
+        exact_->put(path, buffer.data(), buffer.size());
+      }
+    }
+    publish(current->base_, current->delta_, current->removed_);
+    return core::Result<void, Error>::Ok();
+  }
+
+  core::Result<void> upsert(const std::string &path, std::vector<float> vector,
+                            const FileMeta &meta = {}) {
+    std::lock_guard lock(writer_);
+    const auto current = snapshot();
+
+    if (exact_) {
+      faiss::fvec_renorm_L2(vector.size(), 1, vector.data());
+      auto stored = exact_->put(path, vector.data(), vector.size());
+      if (!stored.is_ok()) {
+        return stored;
+      }
+    }
+
+    std::shared_ptr<const VectorIndex> base = current->base_;
+    std::shared_ptr<VectorIndex> delta;
+    if (!base) {
+      base = std::make_shared<const VectorIndex>(vector.size());
+      delta = std::make_shared<VectorIndex>(vector.size());
+    } else {
+      delta = current->delta_->clone();
+    }
+
+    auto r = delta->upsert(path, std::move(vector), meta);
+    if (!r.is_ok()) {
+      return r;
+    }
+    touch(path);
+
+    auto removed = current->removed_;
+    if (base->contains(path) && !(removed && removed->count(path))) {
+      auto shadowed = std::make_shared<VectorSnapshot::PathSet>(
+          removed ? *removed : VectorSnapshot::PathSet{});
+      shadowed->insert(path);
+      removed = std::move(shadowed);
+    }
+
+    publish(std::move(base), std::move(delta), std::move(removed));
+    return core::Result<void, Error>::Ok();
+  }
+
+  bool remove(const std::string &path) {
+    std::lock_guard lock(writer_);
+    const auto current = snapshot();
+    if (!current->contains(path)) {
+      return false;
+    }
+    if (exact_) {
+      exact_->erase(path);
+    }
+    touch(path);
+
+    std::shared_ptr<const VectorIndex> delta = current->delta_;
+    if (delta->contains(path)) {
+      auto copy = delta->clone();
+      copy->remove(path);
+      delta = std::move(copy);
+    }
+
+    auto removed = current->removed_;
+    if (current->base_->contains(path) && !removed->count(path)) {
+      auto shadowed = std::make_shared<VectorSnapshot::PathSet>(*removed);
+      shadowed->insert(path);
+      removed = std::move(shadowed);
+    }
+
+    publish(current->base_, std::move(delta), std::move(removed));
+    return true;
+  }
+
+  // Applies several removals and upserts as one published snapshot, copying
+  // the delta once instead of once per change.
+  core::Result<void>
+  apply(const std::vector<std::string> &removals,
+        std::vector<std::pair<std::string, std::vector<float>>> upserts) {
+    std::lock_guard lock(writer_);
+    const auto current = snapshot();
+    if (!current->base_ && upserts.empty()) {
+      return core::Result<void, Error>::Ok();
+    }
+
+    const auto dimension = current->base_ ? current->dimension()
+                                          : upserts.front().second.size();
+    std::shared_ptr<const VectorIndex> base = current->base_;
+    std::shared_ptr<VectorIndex> delta;
+    auto removed = std::make_shared<VectorSnapshot::PathSet>();
+    if (!base) {
+      base = std::make_shared<const VectorIndex>(dimension);
+      delta = std::make_shared<VectorIndex>(dimension);
+    } else {
+      delta = current->delta_->clone();
+      *removed = *current->removed_;
+    }
+
+    for (const auto &path : removals) {
+      if (exact_) {
+        exact_->erase(path);
+      }
+      delta->remove(path);
+      touch(path);
+      if (base->contains(path)) {
+        removed->insert(path);
+      }
+    }
+
+    for (auto &[path, vector] : upserts) {
+      if (exact_) {
+        faiss::fvec_renorm_L2(vector.size(), 1, vector.data());
+        auto stored = exact_->put(path, vector.data(), vector.size());
+        if (!stored.is_ok()) {
+          return stored;
+        }
+      }
+      auto r = delta->upsert(path, std::move(vector));
+      if (!r.is_ok()) {
+        return r;
+      }
+      touch(path);
+      if (base->contains(path)) {
+        removed->insert(path);
+      }
+    }
+
+    publish(std::move(base), std::move(delta), std::move(removed));
+    return core::Result<void, Error>::Ok();
+  }
+
+  // Sets metadata for vectors that are already stored, e.g. ones loaded from
+  // a snapshot written before the columns existed. Costs one copy of the base.
+  void annotate(const std::vector<std::pair<std::string, FileMeta>> &metas) {
+    std::lock_guard lock(writer_);
+    const auto current = snapshot();
+    if (!current->base_ || metas.empty()) {
+      return;
+    }
+
+    auto base = current->base_->clone();
+    auto delta = current->delta_->clone();
+    for (const auto &[path, meta] : metas) {
+      if (!delta->annotate(path, meta) && !current->removed_->count(path)) {
+        base->annotate(path, meta);
+      }
+      touch(path);
+    }
+    publish(std::move(base), std::move(delta), current->removed_);
+  }
+
+  // Replaces everything with `base`, e.g. a snapshot loaded from disk.
+  void reset(std::shared_ptr<const VectorIndex> base) {
+    std::lock_guard lock(writer_);
+    ++epoch_;
+    if (!base) {
+      current_.store(std::make_shared<const VectorSnapshot>(),
+                     std::memory_order_release);
+      return;
+    }
+
+    auto delta = std::make_shared<const VectorIndex>(base->dimension());
+    publish(std::move(base), std::move(delta), nullptr);
+  }
+
+  // Drops the in-memory index and the exact store; whatever save() last wrote
+  // stays on disk. Readers keep the snapshots they already hold.
+  void unload() {
+    std::lock_guard lock(writer_);
+    ++epoch_;
+    exact_.reset();
+    current_.store(std::make_shared<const VectorSnapshot>(),
+                   std::memory_order_release);
+  }
+
+  core::Result<void> save(const fs::path &dir) {
+    std::lock_guard lock(writer_);
+    const auto current = snapshot();
+    if (!current->base_) {
+      return core::Result<void, Error>::Ok();
+    }
+
+    mergeLocked();
+    auto saved = snapshot()->base_->save(dir);
+    if (!saved.is_ok() || !exact_) {
+      return saved;
+    }
+    return exact_->flush();
+  }
+
+private:
+  // What a rebuild should produce; see planRebuild().
+  struct RebuildPlan {
+    std::string target;
+    bool migrate = false;
+    std::size_t dead = 0;
+  };
+
+  void publish(std::shared_ptr<const VectorIndex> base,
+               std::shared_ptr<const VectorIndex> delta,
+               std::shared_ptr<const VectorSnapshot::PathSet> removed) {
+    install(std::move(base), std::move(delta), std::move(removed));
+
+    // Removals count too: each one is copied with every later change and
+    // over-fetched by every query until a merge folds it into the base.
+    const auto published = snapshot();
+    if (published->delta_->size() + published->removed_->size() >=
+        kMergeThreshold) {
+      mergeLocked();
+    }
+  }
+
+  void install(std::shared_ptr<const VectorIndex> base,
+               std::shared_ptr<const VectorIndex> delta,
+               std::shared_ptr<const VectorSnapshot::PathSet> removed) {
+    auto next = std::make_shared<VectorSnapshot>();
+    next->base_ = std::move(base);
+    next->delta_ = std::move(delta);
+    next->removed_ = removed ? std::move(removed)
+                             : std::make_shared<const VectorSnapshot::PathSet>();
+    next->exact_ = exact_;
+    next->defaults_ = config_.defaults();
+    next->generation_ = snapshot()->generation_ + 1;
+    current_.store(std::move(next), std::memory_order_release);
+  }
+
+  // Folds the delta into a copy of the base. A rebuild the base needs is
+  // started in the background first, from the same snapshot.
+  void mergeLocked() {
+    const auto current = snapshot();
+    if (!touched_) {
+      if (auto plan = planRebuild(*current)) {
+        startRebuild(current, std::move(*plan));
+      }
+    }
+
+    if (current->delta_->size() == 0 && current->removed_->empty()) {
+      return;
+    }
+    std::shared_ptr<VectorIndex> merged = current->base_->clone();
+    for (const auto &path : *current->removed_) {
+      merged->remove(path);
+    }
+    current->delta_->forEach(
+        [&](const std::string &path, const std::vector<float> &vector) {
+          merged->upsert(path, vector,
+                         current->delta_->meta(path).value_or(FileMeta{}));
+        });
+
+    auto next = std::make_shared<VectorSnapshot>();
+    next->delta_ = std::make_shared<const VectorIndex>(merged->dimension());
+    next->base_ = std::move(merged);
+    next->removed_ = std::make_shared<const VectorSnapshot::PathSet>();
+    next->exact_ = exact_;
+    next->defaults_ = config_.defaults();
+    next->generation_ = current->generation_ + 1;
+    current_.store(std::move(next), std::memory_order_release);
+  }
+
+  // The base is rebuilt as the configured index type when the current one no
+  // longer fits. Automatic selection only moves towards more scalable types
+  // (or, within Flat and HNSW, to the configured storage), so a container
+  // hovering around a threshold does not flip back and forth. Vectors come
+  // from the exact store when there is one, so requantising never compounds
+  // error; IVF bases are only rebuilt from a store that covers them.
+  //
+  // An HNSW base is also rebuilt as its own type once merging would leave
+  // more than kMaxTombstoneRatio of its vectors dead, since the graph cannot
+  // drop them and every search over-fetches by their number.
+  std::optional<RebuildPlan> planRebuild(const VectorSnapshot &current) const {
+    const auto &base = *current.base_;
+    const auto count = current.size();
+    auto target = config_.factoryFor(count, base.dimension());
+    const auto family = indexFamily(target);
+    const bool forward =
+        family > base.family() ||
+        (family == base.family() && family != IndexFamily::Ivf);
+    const bool readable = base.family() != IndexFamily::Ivf ||
+                          (exact_ && exact_->size() >= count);
+
+    const bool migrate = target != base.factory() && readable &&
+                         count >= IndexConfig::minTrainingSize(target) &&
+                         (!config_.automatic() || forward);
+    const auto dead = tombstonesAfterMerge(current);
+    const bool compact =
+        dead > kMaxTombstoneRatio *
+                   static_cast<double>(base.size() + base.tombstones());
+    if (!migrate && !compact) {
+      return std::nullopt;
+    }
+    if (!migrate) {
+      target = base.factory();
+    }
+    return RebuildPlan{std::move(target), migrate, dead};
+  }
+
+  // Paths written while a rebuild runs are replayed over its result.
+  void touch(const std::string &path) {
+    if (touched_) {
+      touched_->insert(path);
+    }
+  }
+
+  void startRebuild(Snapshot from, RebuildPlan plan) {
+    if (rebuild_.joinable()) {
+      rebuild_.join();
+    }
+    touched_.emplace();
+    rebuild_ = std::thread([this, from = std::move(from),
+                            plan = std::move(plan), config = config_,
+                            exact = exact_, epoch = epoch_]() {
+      std::shared_ptr<VectorIndex> built;
+      try {
+        built = buildBase(*from, plan, config, exact.get());
+      } catch (const std::exception &e) {
+        spdlog::warn("Vector index rebuild as {} failed: {}", plan.target,
+                     e.what());
+      }
+
+      std::lock_guard lock(writer_);
+      auto touched = std::move(*touched_);
+      touched_.reset();
+      rebuilt_.notify_all();
+      if (built && epoch == epoch_) {
+        swapInLocked(std::move(built), touched);
+      }
+    });
+  }
+
+  // The new base covers the snapshot it was built from; everything written
+  // since goes into the delta, or into the removals where it was deleted.
+  void swapInLocked(std::shared_ptr<VectorIndex> built,
+                    const VectorSnapshot::PathSet &touched) {
+    const auto current = snapshot();
+    auto delta = std::make_shared<VectorIndex>(built->dimension());
+    auto removed = std::make_shared<VectorSnapshot::PathSet>();
+    std::vector<float> vector(built->dimension());
+    for (const auto &path : touched) {
+      if (built->contains(path)) {
+        removed->insert(path);
+      }
+      if (!current->contains(path)) {
+        continue;
+      }
+      if ((exact_ && exact_->read(path, vector.data())) ||
+          current->reconstruct(path, vector.data())) {
+        delta->upsert(path, vector,
+                      current->meta(path).value_or(FileMeta{}));
+      }
+    }
+    install(std::move(built), std::move(delta), std::move(removed));
+  }
+
+  // Runs without the writer lock: `from` is immutable and the exact store
+  // locks itself. Null if the build failed.
+  static std::shared_ptr<VectorIndex>
+  buildBase(const VectorSnapshot &from, const RebuildPlan &plan,
+            const IndexConfig &config, const ExactVectorStore *exact) {
+    const auto &base = *from.base_;
+    const auto &target = plan.target;
+    const auto count = from.size();
+
+    std::vector<std::pair<std::string, std::vector<float>>> items;
+    items.reserve(count);
+    if (base.family() == IndexFamily::Ivf) {
+      exact->forEach([&](const std::string &path, const std::vector<float> &v) {
+        if (base.contains(path) && !from.removed_->count(path)) {
+          items.emplace_back(path, v);
+        }
+      });
+    } else {
+      base.forEach([&](const std::string &path, const std::vector<float> &v) {
+        if (!from.removed_->count(path)) {
+          items.emplace_back(path, v);
+        }
+      });
+      if (exact && !base.exact()) {
+        for (auto &[path, v] : items) {
+          exact->read(path, v.data());
+        }
+      }
+    }
+    from.delta_->forEach(
+        [&](const std::string &path, const std::vector<float> &v) {
+          items.emplace_back(path, v);
+        });
+
+    auto built = VectorIndex::build(base.dimension(), target, items, config);
+    if (!built.is_ok()) {
+      spdlog::warn("Vector index migration to {} failed: {}", target,
+                   built.error().what());
+      return nullptr;
+    }
+
+    for (const auto &[path, v] : items) {
+      if (auto meta = from.meta(path)) {
+        built.value()->annotate(path, *meta);
+      }
+    }
+
+    if (plan.migrate) {
+      spdlog::info("Vector index migrated from {} to {} at {} vectors",
+                   base.factory(), target, count);
+    } else {
+      spdlog::info("Vector index {} rebuilt to drop {} dead vectors", target,
+                   plan.dead);
+    }
+    if (const auto &recall = built.value()->recall()) {
+      spdlog::info("{} recall@{}: {:.3f} raw, {:.3f} re-ranked ({} queries)",
+                   target, VectorIndex::kRecallDepth, recall->raw,
+                   recall->reranked, recall->queries);
+    }
+    return built.value();
+  }
+
+  // Vectors the base would still hold for removed or replaced paths once
+  // `current` is merged into it; only HNSW bases keep them. Replaced paths
+  // are in removed_ as well.
+  static std::size_t tombstonesAfterMerge(const VectorSnapshot &current) {
+    const auto &base = *current.base_;
+    if (base.family() != IndexFamily::Hnsw) {
+      return 0;
+    }
+    return base.tombstones() + current.removed_->size();
+  }
+
+  std::mutex writer_;
+  IndexConfig config_;
+  std::shared_ptr<ExactVectorStore> exact_;
+  std::atomic<Snapshot> current_;
+
+  // Set while a rebuild runs. epoch_ moves on when the contents are replaced
+  // wholesale, so a rebuild started before that is dropped.
+  std::optional<VectorSnapshot::PathSet> touched_;
+  std::uint64_t epoch_ = 0;
+  std::condition_variable rebuilt_;
+  std::thread rebuild_;
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_INDEX_VERSIONED_VECTOR_INDEX
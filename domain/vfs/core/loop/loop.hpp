@@ -10,6 +10,8 @@ namespace owl {
 
 class EventLoop {
 public:
+  using Strand = boost::asio::strand<boost::asio::io_context::executor_type>;
+
   EventLoop(size_t thread_count = std::thread::hardware_concurrency())
       : thread_count_(thread_count),
         io_context_(std::make_shared<boost::asio::io_context>()),
@@ -38,6 +40,10 @@ public:
     post(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
   }
 
+  // Tasks posted to one strand run one at a time, in posting order, on
+  // whichever pool thread is free.
+  Strand make_strand() { return boost::asio::make_strand(*io_context_); }
+
   boost::asio::io_context &get_io_context() { return *io_context_; }
 
 private:
@@ -0,0 +1,81 @@
+#ifndef OWL_VFS_CORE_LOOP_MPSC_RING
+#define OWL_VFS_CORE_LOOP_MPSC_RING
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+namespace owl {
+
+// Bounded lock-free multi-producer / single-consumer ring (Vyukov's
+// sequence-per-slot scheme). A producer claims a slot with one CAS on the
+// tail and publishes it by bumping the slot's sequence; nothing ever blocks.
+// When the ring is full tryPush() fails and the caller decides what to drop.
+template <typename T> class MpscRing {
+public:
+  explicit MpscRing(std::size_t capacity)
+      : mask_(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity) - 1),
+        slots_(std::make_unique<Slot[]>(mask_ + 1)) {
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscRing(const MpscRing &) = delete;
+  MpscRing &operator=(const MpscRing &) = delete;
+
+  std::size_t capacity() const { return mask_ + 1; }
+
+  bool tryPush(T value) {
+    auto position = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+      auto &slot = slots_[position & mask_];
+      const auto sequence = slot.sequence.load(std::memory_order_acquire);
+      const auto lag = static_cast<std::ptrdiff_t>(sequence) -
+                       static_cast<std::ptrdiff_t>(position);
+      if (lag == 0) {
+        if (tail_.compare_exchange_weak(position, position + 1,
+                                        std::memory_order_relaxed)) {
+          slot.value = std::move(value);
+          slot.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lag < 0) {
+        return false;
+      } else {
+        position = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Consumer side; only one thread may call it.
+  std::optional<T> tryPop() {
+    auto &slot = slots_[head_ & mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) {
+      return std::nullopt;
+    }
+    T value = std::move(slot.value);
+    slot.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+    ++head_;
+    return value;
+  }
+
+private:
+  static constexpr std::size_t kCacheLine = 64;
+
+  struct alignas(kCacheLine) Slot {
+    std::atomic<std::size_t> sequence{0};
+    T value{};
+  };
+
+  const std::size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  alignas(kCacheLine) std::atomic<std::size_t> tail_{0};
+  alignas(kCacheLine) std::size_t head_ = 0;
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_LOOP_MPSC_RING
@@ -0,0 +1,59 @@
+#ifndef OWL_VFS_CORE_LOOP_PERIODIC_TASK
+#define OWL_VFS_CORE_LOOP_PERIODIC_TASK
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace owl {
+
+// Runs `task` on its own thread straight away and then every `interval`.
+// Destruction interrupts the wait instead of sitting it out, and returns once
+// a run in progress has finished. Declare it after whatever `task` uses.
+class PeriodicTask {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  PeriodicTask(Clock::duration interval, std::function<void()> task)
+      : interval_(interval), task_(std::move(task)),
+        thread_([this] { run(); }) {}
+
+  ~PeriodicTask() {
+    {
+      std::lock_guard lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+  }
+
+  PeriodicTask(const PeriodicTask &) = delete;
+  PeriodicTask &operator=(const PeriodicTask &) = delete;
+
+  Clock::duration interval() const { return interval_; }
+
+private:
+  void run() {
+    std::unique_lock lock(mutex_);
+    while (!stop_) {
+      lock.unlock();
+      task_();
+      lock.lock();
+      wake_.wait_for(lock, interval_, [this] { return stop_; });
+    }
+  }
+
+  const Clock::duration interval_;
+  std::function<void()> task_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stop_ = false;
+  std::thread thread_;
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_LOOP_PERIODIC_TASK
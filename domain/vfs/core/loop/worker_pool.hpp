@@ -0,0 +1,51 @@
+#ifndef OWL_VFS_CORE_LOOP_WORKER_POOL
+#define OWL_VFS_CORE_LOOP_WORKER_POOL
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <future>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+namespace owl {
+
+class WorkerPool {
+public:
+  explicit WorkerPool(
+      std::size_t thread_count = std::thread::hardware_concurrency())
+      : pool_(thread_count == 0 ? 1 : thread_count) {}
+
+  ~WorkerPool() { stop(); }
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  template <typename Task>
+  auto submit(Task &&task) -> std::future<std::invoke_result_t<Task>> {
+    using ResultT = std::invoke_result_t<Task>;
+
+    auto packaged = std::make_shared<std::packaged_task<ResultT()>>(
+        std::forward<Task>(task));
+    auto future = packaged->get_future();
+
+    boost::asio::post(pool_, [packaged]() { (*packaged)(); });
+    return future;
+  }
+
+  template <typename Task> void post(Task &&task) {
+    boost::asio::post(pool_, std::forward<Task>(task));
+  }
+
+  void stop() {
+    pool_.stop();
+    pool_.join();
+  }
+
+private:
+  boost::asio::thread_pool pool_;
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_LOOP_WORKER_POOL
@@ -4,6 +4,10 @@
 #include <boost/fusion/functional.hpp>
 #include <boost/hana.hpp>
 #include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+
+#include "vfs/core/schemas/payload.hpp"
 
 namespace owl {
 
@@ -12,6 +16,12 @@ struct BaseEvent {
   std::string type;
   nlohmann::json data;
 
+  // Declared so that the virtual destructor does not turn moves into copies.
+  BaseEvent() = default;
+  BaseEvent(const BaseEvent &) = default;
+  BaseEvent(BaseEvent &&) noexcept = default;
+  BaseEvent &operator=(const BaseEvent &) = default;
+  BaseEvent &operator=(BaseEvent &&) noexcept = default;
   virtual ~BaseEvent() = default;
 };
 
@@ -33,6 +43,11 @@ struct GetContainerFilesEvent : BaseEvent {
   bool rebuild_index = false;
 };
 
+struct ContainerMetricsEvent : BaseEvent {
+  std::string container_id;
+  std::string user_id;
+};
+
 struct ContainerDeleteEvent : BaseEvent {
   std::string user_id;
   std::string container_id;
@@ -40,7 +55,7 @@ struct ContainerDeleteEvent : BaseEvent {
 
 struct FileCreateEvent : BaseEvent {
   std::string path;
-  std::string content;
+  Payload content;
   std::string user_id;
   std::string container_id;
 };
@@ -56,6 +71,40 @@ struct SemanticSearchEvent : BaseEvent {
   int limit = 10;
   std::string user_id;
   std::string container_id;
+  std::optional<std::string> mode;
+  std::optional<int> nprobe;
+  std::optional<int> ef_search;
+  std::optional<std::string> path_prefix;
+  std::optional<std::string> category;
+  std::optional<std::size_t> mtime_from;
+  std::optional<std::size_t> mtime_to;
+  std::optional<std::vector<std::string>> labels;
+};
+
+struct SemanticSearchBatchEvent : BaseEvent {
+  std::vector<std::string> queries;
+  int limit = 10;
+  std::string user_id;
+  std::string container_id;
+  std::optional<int> nprobe;
+  std::optional<int> ef_search;
+};
+
+struct SemanticSearchPassagesEvent : BaseEvent {
+  std::string query;
+  int limit = 10;
+  std::string user_id;
+  std::string container_id;
+  std::optional<int> nprobe;
+  std::optional<int> ef_search;
+};
+
+struct SemanticSearchGlobalEvent : BaseEvent {
+  std::string query;
+  int limit = 10;
+  std::string user_id;
+  std::optional<std::string> mode;
+  std::optional<int> timeout_ms;
 };
 
 struct ContainerStopEvent : BaseEvent {
@@ -63,6 +112,28 @@ struct ContainerStopEvent : BaseEvent {
   std::string container_id;
 };
 
+struct FileSearchEvent : BaseEvent {
+  std::string pattern;
+  std::string user_id;
+  std::optional<int> timeout_ms;
+};
+
+struct BulkImportEvent : BaseEvent {
+  std::string source;
+  std::string user_id;
+  std::string container_id;
+};
+
+struct ContainerCloneEvent : BaseEvent {
+  std::string user_id;
+  std::string container_id;
+  std::string target_id;
+};
+
+struct MQResponseEvent : BaseEvent {
+  bool success = true;
+};
+
 } // namespace owl
 
 BOOST_HANA_ADAPT_STRUCT(owl::ContainerCreateEvent, container_id, user_id,
@@ -72,6 +143,8 @@ BOOST_HANA_ADAPT_STRUCT(owl::ContainerCreateEvent, container_id, user_id,
 BOOST_HANA_ADAPT_STRUCT(owl::GetContainerFilesEvent, container_id, user_id,
                         rebuild_index);
 
+BOOST_HANA_ADAPT_STRUCT(owl::ContainerMetricsEvent, container_id, user_id);
+
 BOOST_HANA_ADAPT_STRUCT(owl::ContainerDeleteEvent, container_id);
 
 BOOST_HANA_ADAPT_STRUCT(owl::FileCreateEvent, path, content, user_id,
@@ -80,10 +153,27 @@ BOOST_HANA_ADAPT_STRUCT(owl::FileCreateEvent, path, content, user_id,
 BOOST_HANA_ADAPT_STRUCT(owl::FileDeleteEvent, path, user_id, container_id);
 
 BOOST_HANA_ADAPT_STRUCT(owl::SemanticSearchEvent, query, limit, user_id,
-                        container_id);
+                        container_id, mode, nprobe, ef_search, path_prefix,
+                        category, mtime_from, mtime_to, labels);
+
+BOOST_HANA_ADAPT_STRUCT(owl::SemanticSearchBatchEvent, queries, limit, user_id,
+                        container_id, nprobe, ef_search);
+
+BOOST_HANA_ADAPT_STRUCT(owl::SemanticSearchPassagesEvent, query, limit,
+                        user_id, container_id, nprobe, ef_search);
+
+BOOST_HANA_ADAPT_STRUCT(owl::SemanticSearchGlobalEvent, query, limit, user_id,
+                        mode, timeout_ms);
 
 BOOST_HANA_ADAPT_STRUCT(owl::ContainerStopEvent, container_id);
 
+BOOST_HANA_ADAPT_STRUCT(owl::FileSearchEvent, pattern, user_id, timeout_ms);
+
+BOOST_HANA_ADAPT_STRUCT(owl::BulkImportEvent, source, user_id, container_id);
+
+BOOST_HANA_ADAPT_STRUCT(owl::ContainerCloneEvent, user_id, container_id,
+                        target_id);
+
 BOOST_HANA_ADAPT_STRUCT(owl::BaseEvent, request_id, type, data);
 
 #endif // OWL_VFS_CORE_SCHEMAS_EVENTS
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef OWL_VFS_CORE_SCHEMAS_PAYLOAD
+#define OWL_VFS_CORE_SCHEMAS_PAYLOAD
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+namespace owl {
+
+// Immutable, reference-counted bytes for the large fields of a request, such
+// as file content. Copies share the one buffer, so an event can be copied
+// onto the loop, a strand and its handler without copying what it carries.
+class Payload {
+public:
+  Payload() = default;
+
+  explicit Payload(std::string bytes)
+      : bytes_(std::make_shared<const std::string>(std::move(bytes))) {}
+
+  const std::string &operator*() const { return bytes_ ? *bytes_ : none(); }
+  const std::string *operator->() const { return &**this; }
+
+  std::string_view view() const { return **this; }
+  std::size_t size() const { return bytes_ ? bytes_->size() : 0; }
+
+  // How many payloads share this buffer.
+  long use_count() const { return bytes_.use_count(); }
+
+  friend void to_json(nlohmann::json &json, const Payload &payload) {
+    json = *payload;
+  }
+
+  friend void from_json(const nlohmann::json &json, Payload &payload) {
+    payload = Payload(json.get<std::string>());
+  }
+
+private:
+  static const std::string &none() {
+    static const std::string empty;
+    return empty;
+  }
+
+  std::shared_ptr<const std::string> bytes_;
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_SCHEMAS_PAYLOAD
@@ -3,6 +3,7 @@
 
 #include <boost/hana.hpp>
 #include <boost/preprocessor.hpp>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -34,6 +35,12 @@ struct ContainerGetFilesSchema {
   bool rebuild_index = false;
 };
 
+struct ContainerMetricsSchema {
+  std::string request_id;
+  std::string container_id;
+  std::string user_id;
+};
+
 struct ContainerSchema {
   std::string request_id;
   std::string container_id;
@@ -54,18 +61,70 @@ struct FileDeleteSchema {
   std::string container_id;
 };
 
+struct FileSearchSchema {
+  std::string request_id;
+  std::string pattern;
+  std::string user_id;
+  std::optional<int> timeout_ms;
+};
+
+struct ContainerCloneSchema {
+  std::string request_id;
+  std::string user_id;
+  std::string container_id;
+  std::string target_id;
+};
+
+struct BulkImportSchema {
+  std::string request_id;
+  std::string source;
+  std::string user_id;
+  std::string container_id;
+};
+
 struct SemanticSearchSchema {
   std::string request_id;
   std::string query;
   int limit = 10;
   std::string user_id;
   std::string container_id;
+  std::optional<std::string> mode;
+  std::optional<int> nprobe;
+  std::optional<int> ef_search;
+  std::optional<std::string> path_prefix;
+  std::optional<std::string> category;
+  std::optional<std::size_t> mtime_from;
+  std::optional<std::size_t> mtime_to;
+  std::optional<std::vector<std::string>> labels;
+};
+
+struct SemanticSearchBatchSchema {
+  std::string request_id;
+  std::vector<std::string> queries;
+  int limit = 10;
+  std::string user_id;
+  std::string container_id;
+  std::optional<int> nprobe;
+  std::optional<int> ef_search;
+};
+
+struct SemanticSearchPassagesSchema {
+  std::string request_id;
+  std::string query;
+  int limit = 10;
+  std::string user_id;
+  std::string container_id;
+  std::optional<int> nprobe;
+  std::optional<int> ef_search;
 };
 
 struct SemanticSearchGlobalSchema {
   std::string request_id;
   std::string query;
   int limit = 10;
+  std::string user_id;
+  std::optional<std::string> mode;
+  std::optional<int> timeout_ms;
 };
 
 struct ContainerStopSchema {
@@ -88,15 +147,28 @@ BOOST_HANA_ADAPT_STRUCT(owl::ContainerUserSchema, request_id, container_id,
                         user_id);
 BOOST_HANA_ADAPT_STRUCT(owl::ContainerGetFilesSchema, request_id, container_id,
                         user_id, rebuild_index);
+BOOST_HANA_ADAPT_STRUCT(owl::ContainerMetricsSchema, request_id, container_id,
+                        user_id);
 BOOST_HANA_ADAPT_STRUCT(owl::ContainerSchema, request_id, container_id);
 BOOST_HANA_ADAPT_STRUCT(owl::FileCreateSchema, request_id, path, content,
                         user_id, container_id);
 BOOST_HANA_ADAPT_STRUCT(owl::FileDeleteSchema, request_id, path, user_id,
                         container_id);
+BOOST_HANA_ADAPT_STRUCT(owl::FileSearchSchema, request_id, pattern, user_id,
+                        timeout_ms);
+BOOST_HANA_ADAPT_STRUCT(owl::ContainerCloneSchema, request_id, user_id,
+                        container_id, target_id);
+BOOST_HANA_ADAPT_STRUCT(owl::BulkImportSchema, request_id, source, user_id,
+                        container_id);
 BOOST_HANA_ADAPT_STRUCT(owl::SemanticSearchSchema, request_id, query, limit,
-                        user_id, container_id);
+                        user_id, container_id, mode, nprobe, ef_search,
+                        path_prefix, category, mtime_from, mtime_to, labels);
+BOOST_HANA_ADAPT_STRUCT(owl::SemanticSearchBatchSchema, request_id, queries,
+                        limit, user_id, container_id, nprobe, ef_search);
+BOOST_HANA_ADAPT_STRUCT(owl::SemanticSearchPassagesSchema, request_id, query,
+                        limit, user_id, container_id, nprobe, ef_search);
 BOOST_HANA_ADAPT_STRUCT(owl::SemanticSearchGlobalSchema, request_id, query,
-                        limit);
+                        limit, user_id, mode, timeout_ms);
 BOOST_HANA_ADAPT_STRUCT(owl::ContainerStopSchema, request_id, container_id);
 BOOST_HANA_ADAPT_STRUCT(owl::ContainerDeleteSchema, request_id, user_id,
                         container_id);
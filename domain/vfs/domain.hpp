@@ -3,8 +3,14 @@
 
 #include <fuse3/fuse.h>
 
+#include "vfs/core/container/cgroup_sampler.hpp"
+#include "vfs/core/container/container_loader.hpp"
 #include "vfs/core/container/container_manager.hpp"
 #include "vfs/core/container/ossec_container.hpp"
+#include "vfs/core/container/residency.hpp"
+#include "vfs/core/index/query_cache.hpp"
+#include "vfs/core/loop/periodic_task.hpp"
+#include "vfs/core/loop/worker_pool.hpp"
 #include "vfs/fs/processor/processor_base.hpp"
 
 #include <infrastructure/event.hpp>
@@ -19,18 +25,85 @@ constexpr auto kBaseContainerPath = "/home/bararide/.vectorfs/containers/";
 constexpr auto kModelPath = "/home/bararide/code/models/crawl-300d-2M-subword/"
                             "crawl-300d-2M-subword.bin";
 
+// Memory the resident container indexes may hold together before the least
+// recently used ones are evicted to their state directories.
+constexpr std::size_t kIndexMemoryBudget = std::size_t{2} << 30;
+
+// Containers brought up at once at start-up, and what requests for one that
+// is still coming up do.
+constexpr std::size_t kBootConcurrency = 4;
+constexpr auto kLoadingPolicy = LoadingPolicy::Queue;
+constexpr auto kLoadingWait = std::chrono::seconds(30);
+
+// How often every container's cgroup is read for /container/metrics.
+constexpr auto kMetricsInterval = std::chrono::seconds(5);
+
+// Bulk imports may only read from under `root`, which by default sits beside
+// the container directory, and at most `concurrency` of them run at once, on
+// their own threads. Archive entries over `max_entry_bytes` are rejected.
+struct ImportConfig {
+  std::filesystem::path root =
+      std::filesystem::path(kBaseContainerPath).parent_path().parent_path() /
+      "imports";
+  std::size_t concurrency = 2;
+  std::uint64_t max_entry_bytes = std::uint64_t{4} << 30;
+};
+
+// Containers whose index has not been pinned for kHibernateAfter are
+// hibernated; the sweep looks for them every kHibernationSweep.
+constexpr auto kHibernateAfter = std::chrono::minutes(30);
+constexpr auto kHibernationSweep = std::chrono::minutes(1);
+
 using OssecContainerPtr = std::shared_ptr<OssecContainer<>>;
 using Containers = std::vector<ossec::Container>;
 
 struct State {
+  State() = default;
+  explicit State(ImportConfig import_config)
+      : import_config_(std::move(import_config)) {}
+
   core::Event events_;
 
   using OssecContainerT = OssecContainer<EmbedderManager<>, chunkees::Search>;
+  // Declared first so that it outlives every container charged to it.
+  ResidencyBudget residency_{kIndexMemoryBudget};
   ContainerManager<OssecContainerT> container_manager_;
+  ContainerLoader loader_{kLoadingPolicy, kLoadingWait};
+  // Declared after the manager so that their threads stop before the
+  // containers they reach are destroyed.
+  CgroupSampler metrics_{kMetricsInterval, [this] { return cgroupTargets(); }};
+  PeriodicTask hibernation_{kHibernationSweep, [this] { hibernateIdle(); }};
 
   EmbedderManager<> global_embedder_{kModelPath};
   chunkees::Search global_search_{global_embedder_};
   semantic::SemanticChunker<> text_chunker_{global_embedder_};
+
+  QueryCache query_cache_;
+
+  WorkerPool workers_;
+  const ImportConfig import_config_;
+  WorkerPool imports_{import_config_.concurrency};
+
+  std::vector<std::pair<std::string, std::filesystem::path>>
+  cgroupTargets() const {
+    std::vector<std::pair<std::string, std::filesystem::path>> targets;
+    for (const auto &container : container_manager_.getAllContainers()) {
+      if (auto path = container->getCgroupPath(); !path.empty()) {
+        targets.emplace_back(container->getId(), std::move(path));
+      }
+    }
+    return targets;
+  }
+
+  void hibernateIdle() {
+    for (const auto &container : container_manager_.getAllContainers()) {
+      if (!container->isHibernated() &&
+          !loader_.isLoading(container->getId()) &&
+          container->idleFor() >= kHibernateAfter) {
+        container->hibernate();
+      }
+    }
+  }
 };
 
 } // namespace owl
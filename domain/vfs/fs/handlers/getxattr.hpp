@@ -2,19 +2,54 @@
 #define OWL_VFS_FS_HANDLER_GETXATTR
 
 #include "handler.hpp"
+#include <cerrno>
+#include <cstring>
 #include <fuse3/fuse.h>
 
 namespace owl {
 
+// Read-only: "path\tscore\n" per related file, best first. Only served
+// while the container's index is resident; FUSE never loads it.
+constexpr auto kRelatedXattr = "user.owl.related";
+
 struct Getxattr final : public Handler<Getxattr> {
   int operator()(const char *path, const char *name, char *value,
                  size_t size) const {
     spdlog::info("Getxattr handler called for path: {}", path);
 
-    return 0;
+    if (strcmp(name, kRelatedXattr) != 0) {
+      return -ENODATA;
+    }
+    return handle_related(path, value, size);
+  }
+
+private:
+  int handle_related(const char *path, char *value, size_t size) const {
+    const auto target = splitContainerPath(path);
+    if (!target) {
+      return -ENODATA;
+    }
+    auto container = state_.container_manager_.getContainer(target->first);
+    if (!container.is_ok()) {
+      return state_.loader_.isLoading(target->first) ? -EAGAIN : -ENOENT;
+    }
+
+    const auto related = container.value()->relatedFiles(target->second);
+    if (!related) {
+      return -ENODATA;
+    }
+    const auto &text = related->text;
+    if (size == 0) {
+      return static_cast<int>(text.size());
+    }
+    if (size < text.size()) {
+      return -ERANGE;
+    }
+    memcpy(value, text.data(), text.size());
+    return static_cast<int>(text.size());
   }
 };
 
 } // namespace owl
 
-#endif // OWL_VFS_FS_HANDLER_GETXATTR
\ No newline at end of file
+#endif // OWL_VFS_FS_HANDLER_GETXATTR
@@ -1,10 +1,33 @@
 #ifndef OWL_VFS_FS_HANDLER
 #define OWL_VFS_FS_HANDLER
 
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
 #include "vfs/domain.hpp"
 
 namespace owl {
 
+constexpr auto kContainersRoot = std::string_view("/.containers/");
+
+// "/.containers/<id>/<file>" -> {id, "/<file>"}.
+inline std::optional<std::pair<std::string, std::string>>
+splitContainerPath(std::string_view path) {
+  if (!path.starts_with(kContainersRoot)) {
+    return std::nullopt;
+  }
+  path.remove_prefix(kContainersRoot.size());
+  const auto slash = path.find('/');
+  if (slash == 0 || slash == std::string_view::npos ||
+      slash + 1 == path.size()) {
+    return std::nullopt;
+  }
+  return std::pair{std::string(path.substr(0, slash)),
+                   std::string(path.substr(slash))};
+}
+
 template <typename Derived> class Handler {
 protected:
   State &state_;
@@ -1,7 +1,10 @@
 #ifndef OWL_VFS_FS_HANDLER_LISTXATTR
 #define OWL_VFS_FS_HANDLER_LISTXATTR
 
+#include "getxattr.hpp"
 #include "handler.hpp"
+#include <cerrno>
+#include <cstring>
 #include <fuse3/fuse.h>
 
 namespace owl {
@@ -10,10 +13,28 @@ struct Listxattr final : public Handler<Listxattr> {
   int operator()(const char *path, char *list, size_t size) const {
     spdlog::info("Listxattr handler called for path: {}", path);
 
-    return 0;
+    const auto target = splitContainerPath(path);
+    if (!target) {
+      return 0;
+    }
+    auto container = state_.container_manager_.getContainer(target->first);
+    if (!container.is_ok() ||
+        !container.value()->relatedFiles(target->second)) {
+      return 0;
+    }
+
+    const auto length = strlen(kRelatedXattr) + 1;
+    if (size == 0) {
+      return static_cast<int>(length);
+    }
+    if (size < length) {
+      return -ERANGE;
+    }
+    memcpy(list, kRelatedXattr, length);
+    return static_cast<int>(length);
   }
 };
 
 } // namespace owl
 
-#endif // OWL_VFS_FS_HANDLER_LISTXATTR
\ No newline at end of file
+#endif // OWL_VFS_FS_HANDLER_LISTXATTR
@@ -0,0 +1,249 @@
+#ifndef OWL_FS_PROCESSOR_MANIFEST
+#define OWL_FS_PROCESSOR_MANIFEST
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <infrastructure/result.hpp>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace fs = std::filesystem;
+
+namespace owl {
+
+inline constexpr const char *kContainerConfigFile = "container_config.json";
+
+// The container_config.json fields FSProcessor builds a container from.
+struct ContainerConfig {
+  std::string owner = "unknown";
+  std::vector<std::string> commands;
+  std::uint64_t memory_limit_mb = 512;
+  std::uint64_t storage_quota_mb = 1024;
+  std::uint64_t file_limit = 100;
+  std::string environment = "development";
+  std::string type = "default";
+  std::string status = "stopped";
+
+  static ContainerConfig fromJson(const nlohmann::json &json) {
+    ContainerConfig config;
+    config.owner = json.value("owner", config.owner);
+    if (json.contains("commands") && json["commands"].is_array()) {
+      config.commands = json["commands"].get<std::vector<std::string>>();
+    }
+    config.memory_limit_mb =
+        json.value("memory_limit", config.memory_limit_mb);
+    config.storage_quota_mb =
+        json.value("storage_quota", config.storage_quota_mb);
+    config.file_limit = json.value("file_limit", config.file_limit);
+    config.environment = json.value("environment", config.environment);
+    config.type = json.value("type", config.type);
+    config.status = json.value("status", config.status);
+    return config;
+  }
+};
+
+// What a config file looked like when it was parsed: one stat() to compare.
+struct ConfigStamp {
+  std::int64_t mtime_ns = 0;
+  std::uint64_t size = 0;
+
+  bool operator==(const ConfigStamp &) const = default;
+
+  // Nullopt unless `path` (relative to the directory `dir_fd`, or to the
+  // working directory by default) is a regular file.
+  static std::optional<ConfigStamp> of(const char *path,
+                                       int dir_fd = AT_FDCWD) {
+    struct stat st;
+    if (::fstatat(dir_fd, path, &st, 0) != 0 || !S_ISREG(st.st_mode)) {
+      return std::nullopt;
+    }
+    return ConfigStamp{static_cast<std::int64_t>(st.st_mtim.tv_sec) *
+                               1'000'000'000 +
+                           st.st_mtim.tv_nsec,
+                       static_cast<std::uint64_t>(st.st_size)};
+  }
+};
+
+// Every container config under the base directory as last parsed, kept in
+// one binary file next to the containers. At boot each config is only
+// stat()ed against its stamp here; JSON is parsed just for the ones that
+// changed. A manifest that is missing, truncated or from another version is
+// treated as empty, so the worst case is the full parse it replaces.
+class ContainerManifest {
+public:
+  using Error = std::runtime_error;
+
+  static constexpr const char *kFile = ".owl_manifest";
+
+  struct Entry {
+    ConfigStamp stamp;
+    ContainerConfig config;
+  };
+
+  static ContainerManifest load(const fs::path &base) {
+    ContainerManifest manifest;
+    std::ifstream in(base / kFile, std::ios::binary);
+    if (!in) {
+      return manifest;
+    }
+    const std::string data((std::istreambuf_iterator<char>(in)),
+                           std::istreambuf_iterator<char>());
+
+    try {
+      Reader reader{data};
+      if (reader.bytes(sizeof(kMagic)) !=
+              std::string_view(kMagic, sizeof(kMagic)) ||
+          reader.u64() != kVersion) {
+        return manifest;
+      }
+
+      const auto count = reader.count();
+      manifest.entries_.reserve(count);
+      for (std::uint64_t i = 0; i < count; ++i) {
+        auto id = reader.string();
+        Entry entry;
+        entry.stamp.mtime_ns = static_cast<std::int64_t>(reader.u64());
+        entry.stamp.size = reader.u64();
+        auto &config = entry.config;
+        config.owner = reader.string();
+        config.commands.resize(reader.count());
+        for (auto &command : config.commands) {
+          command = reader.string();
+        }
+        config.memory_limit_mb = reader.u64();
+        config.storage_quota_mb = reader.u64();
+        config.file_limit = reader.u64();
+        config.environment = reader.string();
+        config.type = reader.string();
+        config.status = reader.string();
+        manifest.entries_.emplace(std::move(id), std::move(entry));
+      }
+    } catch (const std::exception &e) {
+      spdlog::warn("Ignoring container manifest in {}: {}", base.string(),
+                   e.what());
+      return {};
+    }
+    return manifest;
+  }
+
+  // Written to a temporary and renamed into place.
+  core::Result<void> save(const fs::path &base) const {
+    std::string data(kMagic, sizeof(kMagic));
+    putU64(data, kVersion);
+    putU64(data, entries_.size());
+    for (const auto &[id, entry] : entries_) {
+      putString(data, id);
+      putU64(data, static_cast<std::uint64_t>(entry.stamp.mtime_ns));
+      putU64(data, entry.stamp.size);
+      const auto &config = entry.config;
+      putString(data, config.owner);
+      putU64(data, config.commands.size());
+      for (const auto &command : config.commands) {
+        putString(data, command);
+      }
+      putU64(data, config.memory_limit_mb);
+      putU64(data, config.storage_quota_mb);
+      putU64(data, config.file_limit);
+      putString(data, config.environment);
+      putString(data, config.type);
+      putString(data, config.status);
+    }
+
+    try {
+      const auto tmp = base / (std::string(kFile) + ".tmp");
+      std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+      out.write(data.data(), static_cast<std::streamsize>(data.size()));
+      out.close();
+      if (!out) {
+        return core::Result<void, Error>::Error(
+            Error("failed to write " + tmp.string()));
+      }
+      fs::rename(tmp, base / kFile);
+      return core::Result<void, Error>::Ok();
+    } catch (const std::exception &e) {
+      return core::Result<void, Error>::Error(
+          Error(std::string("container manifest save failed: ") + e.what()));
+    }
+  }
+
+  // The cached config for `id`, if it was parsed from a file with `stamp`.
+  const ContainerConfig *find(const std::string &id,
+                              const ConfigStamp &stamp) const {
+    auto it = entries_.find(id);
+    return it != entries_.end() && it->second.stamp == stamp
+               ? &it->second.config
+               : nullptr;
+  }
+
+  void reserve(std::size_t n) { entries_.reserve(n); }
+
+  void put(std::string id, ConfigStamp stamp, ContainerConfig config) {
+    entries_.insert_or_assign(std::move(id),
+                              Entry{stamp, std::move(config)});
+  }
+
+  std::size_t size() const { return entries_.size(); }
+
+private:
+  static constexpr char kMagic[4] = {'O', 'W', 'L', 'M'};
+  static constexpr std::uint64_t kVersion = 1;
+
+  // Bounds-checked cursor over the file; throws on truncation.
+  struct Reader {
+    std::string_view data;
+    std::size_t at = 0;
+
+    std::string_view bytes(std::size_t n) {
+      if (n > data.size() - at) {
+        throw std::runtime_error("truncated");
+      }
+      auto out = data.substr(at, n);
+      at += n;
+      return out;
+    }
+
+    std::uint64_t u64() {
+      std::uint64_t value;
+      std::memcpy(&value, bytes(sizeof(value)).data(), sizeof(value));
+      return value;
+    }
+
+    std::string string() { return std::string(bytes(u64())); }
+
+    // An element count; each element takes at least eight bytes.
+    std::uint64_t count() {
+      const auto n = u64();
+      if (n > (data.size() - at) / sizeof(std::uint64_t)) {
+        throw std::runtime_error("bad count");
+      }
+      return n;
+    }
+  };
+
+  static void putU64(std::string &out, std::uint64_t value) {
+    out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+
+  static void putString(std::string &out, const std::string &value) {
+    putU64(out, value.size());
+    out.append(value);
+  }
+
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+} // namespace owl
+
+#endif // OWL_FS_PROCESSOR_MANIFEST
@@ -1,6 +1,12 @@
 #ifndef OWL_FS_PROCESSOR_PROCESSOR_BASE
 #define OWL_FS_PROCESSOR_PROCESSOR_BASE
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+
+#include "manifest.hpp"
 #include "utils.hpp"
 
 namespace owl {
@@ -10,33 +16,83 @@ public:
   explicit FSProcessor(const std::string_view &base_path)
       : base_path_(base_path) {}
 
+  // One directory pass and one stat() per container; configs are parsed
+  // only if the ContainerManifest has no entry for their current stamp,
+  // and the manifest is rewritten when anything changed.
   std::vector<ossec::Container> parseBaseDir() const {
-    if (!isDirectory(base_path_)) {
+    const auto started = std::chrono::steady_clock::now();
+    const fs::path base(base_path_);
+
+    std::error_code ec;
+    fs::directory_iterator it(base, ec);
+    const int base_fd = ::open(base.c_str(), O_RDONLY | O_DIRECTORY);
+    if (ec || base_fd < 0) {
+      if (base_fd >= 0) {
+        ::close(base_fd);
+      }
       spdlog::error("Base directory does not exist or is not a directory: {}",
                     base_path_);
       return {};
     }
 
-    auto subdirs = listSubdirectories(base_path_);
+    const auto cached = ContainerManifest::load(base);
+    ContainerManifest manifest;
+    manifest.reserve(cached.size());
     std::vector<ossec::Container> containers;
+    containers.reserve(cached.size());
+    std::size_t parsed = 0;
 
-    for (const auto &subdir : subdirs) {
-      auto container_path = (fs::path(base_path_) / subdir).string();
+    std::string config_file;
+    for (const auto &entry : it) {
+      if (!entry.is_directory(ec)) {
+        continue;
+      }
+      auto subdir = entry.path().filename().string();
+      const auto container_path = (base / subdir).string();
+      config_file.assign(subdir).append("/").append(kContainerConfigFile);
 
       try {
-        auto container = loadContainer(container_path);
-        containers.push_back(std::move(container));
+        const auto stamp = ConfigStamp::of(config_file.c_str(), base_fd);
+        if (!stamp) {
+          throw std::runtime_error("Config file does not exist: " +
+                                   (base / config_file).string());
+        }
+
+        ContainerConfig config;
+        if (const auto *hit = cached.find(subdir, *stamp)) {
+          config = *hit;
+        } else {
+          config = ContainerConfig::fromJson(
+              readJsonFile((base / config_file).string()));
+          ++parsed;
+        }
+
+        containers.push_back(makeContainer(subdir, container_path, config));
+        manifest.put(std::move(subdir), *stamp, std::move(config));
       } catch (const std::exception &e) {
         spdlog::warn("Failed to load container {}: {}", subdir, e.what());
       }
     }
+    ::close(base_fd);
+
+    // With nothing parsed every entry came from `cached`, so equal sizes
+    // mean nothing was added or removed either.
+    if (parsed > 0 || manifest.size() != cached.size()) {
+      if (auto r = manifest.save(base); !r.is_ok()) {
+        spdlog::warn("Failed to write container manifest: {}",
+                     r.error().what());
+      }
+    }
 
+    spdlog::info("Scanned {} containers in {} ms ({} configs parsed)",
+                 containers.size(),
+                 std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::steady_clock::now() - started)
+                     .count(),
+                 parsed);
     return containers;
   }
 
-private:
-  std::string base_path_;
-
   ossec::Container loadContainer(const std::string &container_path) const {
     if (!isDirectory(container_path)) {
       throw std::runtime_error("Container path is not a directory: " +
@@ -46,41 +102,42 @@ private:
     auto abs_path = getAbsolutePath(container_path);
     std::string container_id = abs_path.filename().string();
 
-    std::string config_path = (abs_path / "container_config.json").string();
+    std::string config_path = (abs_path / kContainerConfigFile).string();
     if (!fileExists(config_path)) {
       throw std::runtime_error("Config file does not exist: " + config_path);
     }
 
-    auto config = readJsonFile(config_path);
+    return makeContainer(container_id, container_path,
+                         ContainerConfig::fromJson(readJsonFile(config_path)));
+  }
 
+private:
+  static ossec::Container makeContainer(const std::string &container_id,
+                                        const std::string &container_path,
+                                        const ContainerConfig &config) {
     ossec::Container container;
 
     container.container_id = container_id;
-    container.owner_id = config.value("owner", "unknown");
+    container.owner_id = config.owner;
     container.data_path = container_path;
 
     container.vectorfs_config.mount_namespace = container_id;
+    container.vectorfs_config.commands = config.commands;
 
-    if (config.contains("commands") && config["commands"].is_array()) {
-      container.vectorfs_config.commands =
-          config["commands"].get<std::vector<std::string>>();
-    }
+    container.resources.memory_capacity = config.memory_limit_mb * 1024 * 1024;
+    container.resources.storage_quota = config.storage_quota_mb * 1024 * 1024;
+    container.resources.max_open_files = config.file_limit;
 
-    container.resources.memory_capacity =
-        config.value("memory_limit", 512) * 1024 * 1024;
-    container.resources.storage_quota =
-        config.value("storage_quota", 1024) * 1024 * 1024;
-    container.resources.max_open_files = config.value("file_limit", 100);
-
-    container.labels = {
-        {"environment", config.value("environment", "development")},
-        {"type", config.value("type", "default")},
-        {"status", config.value("status", "stopped")}};
+    container.labels = {{"environment", config.environment},
+                        {"type", config.type},
+                        {"status", config.status}};
 
     container.cgroup_path = "/sys/fs/cgroup/vectorfs/" + container_id;
 
     return container;
   }
+
+  std::string base_path_;
 };
 
 } // namespace owl
@@ -32,19 +32,26 @@ public:
         static_cast<Derived *>(this)->template operator()<Schema, Event>(
             std::forward<Args>(args)...);
 
-    result.handle(
-        [this](const Event &event) {
-          spdlog::critical("Controller отправляет Notify");
-          spdlog::critical("Тип события: {}", typeid(Event).name());
-          state_.events_.template Notify<Event>(std::move(event));
-        },
-        [](auto &err) {
-          spdlog::error("Controller error: {}", err);
-          throw err;
-        });
+    if (!result.is_ok()) {
+      const auto &err = result.error();
+      spdlog::error("Controller error: {}", err);
+      throw err;
+    }
+
+    spdlog::critical("Controller отправляет Notify");
+    spdlog::critical("Тип события: {}", typeid(Event).name());
+    state_.events_.template Notify<Event>(
+        withRequestMeta(std::move(result.value()), args...));
   }
 
 private:
+  template <typename Event>
+  static Event withRequestMeta(Event event, const nlohmann::json &message) {
+    event.request_id = message.value("request_id", "");
+    event.type = message.value("type", "");
+    return event;
+  }
+
   friend Derived;
 };
 
@@ -0,0 +1,18 @@
+#ifndef OWL_MQ_CONTROLLERS_BULK_IMPORT
+#define OWL_MQ_CONTROLLERS_BULK_IMPORT
+
+#include "vfs/mq/controller.hpp"
+
+namespace owl {
+
+struct BulkImportController final : public Controller<BulkImportController> {
+  template <typename Schema, typename Event>
+  auto operator()(const nlohmann::json &message) {
+    return this->validate<Event>(message).map(
+        [](const Event &ev) { return ev; });
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_MQ_CONTROLLERS_BULK_IMPORT
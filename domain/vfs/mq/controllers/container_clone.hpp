@@ -0,0 +1,18 @@
+#ifndef OWL_MQ_CONTROLLERS_CONTAINER_CLONE
+#define OWL_MQ_CONTROLLERS_CONTAINER_CLONE
+
+#include "vfs/mq/controller.hpp"
+
+namespace owl {
+
+struct ContainerCloneController final : public Controller<ContainerCloneController> {
+  template <typename Schema, typename Event>
+  auto operator()(const nlohmann::json &message) {
+    return this->validate<Event>(message).map(
+        [](const Event &ev) { return ev; });
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_MQ_CONTROLLERS_CONTAINER_CLONE
@@ -0,0 +1,19 @@
+#ifndef OWL_MQ_CONTROLLERS_CONTAINER_METRICS
+#define OWL_MQ_CONTROLLERS_CONTAINER_METRICS
+
+#include "vfs/mq/controller.hpp"
+
+namespace owl {
+
+struct ContainerMetricsController final
+    : public Controller<ContainerMetricsController> {
+  template <typename Schema, typename Event>
+  auto operator()(const nlohmann::json &message) {
+    return this->validate<Event>(message).map(
+        [](const Event &ev) { return ev; });
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_MQ_CONTROLLERS_CONTAINER_METRICS
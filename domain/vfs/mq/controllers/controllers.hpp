@@ -2,12 +2,19 @@
 #define OWL_MQ_CONTROLLERS_CONTROLLERS
 
 #include "container_create.hpp"
+#include "container_clone.hpp"
 #include "container_delete.hpp"
 #include "get_container_files.hpp"
+#include "container_metrics.hpp"
 #include "container_stop.hpp"
 #include "file_create.hpp"
 #include "file_delete.hpp"
+#include "file_search.hpp"
+#include "bulk_import.hpp"
 #include "semantic_search.hpp"
+#include "semantic_search_batch.hpp"
+#include "semantic_search_passages.hpp"
+#include "semantic_search_global.hpp"
 
 #include "vfs/mq/core/dispatcher.hpp"
 #include "vfs/mq/core/routing.hpp"
@@ -19,13 +26,20 @@ namespace owl {
 
 using ContainerCreateRoute = Route<Verb::Post, ContainerCreateSchema, ContainerCreateEvent, Path<container_sv, create_sv>, Controller<ContainerCreateController>>;
 using GetContainerFilesRoute = Route<Verb::Get, ContainerGetFilesSchema, GetContainerFilesEvent, Path<container_sv, files_sv>, Controller<ContainerGetFilesController>>;
+using ContainerMetricsRoute = Route<Verb::Get, ContainerMetricsSchema, ContainerMetricsEvent, Path<container_sv, metrics_sv>, Controller<ContainerMetricsController>>;
 using ContainerDeleteRoute = Route<Verb::Delete, ContainerDeleteSchema, ContainerDeleteEvent, Path<container_sv, delete_sv>, Controller<ContainerDeleteController>>;
+using ContainerCloneRoute = Route<Verb::Post, ContainerCloneSchema, ContainerCloneEvent, Path<container_sv, clone_sv>, Controller<ContainerCloneController>>;
 using FileCreateRoute = Route<Verb::Post, FileCreateSchema, FileCreateEvent, Path<file_sv, create_sv>, Controller<FileCreateController>>;
 using FileDeleteRoute = Route<Verb::Delete, FileDeleteSchema, FileDeleteEvent, Path<file_sv, delete_sv>, Controller<FileDeleteController>>;
+using FileSearchRoute = Route<Verb::Post, FileSearchSchema, FileSearchEvent, Path<file_sv, search_sv>, Controller<FileSearchController>>;
+using BulkImportRoute = Route<Verb::Post, BulkImportSchema, BulkImportEvent, Path<file_sv, import_sv>, Controller<BulkImportController>>;
 using ContainerStopRoute = Route<Verb::Post, ContainerStopSchema, ContainerStopEvent, Path<container_sv, stop_sv>, Controller<ContainerStopController>>;
 using SemanticSearchRoute = Route<Verb::Post, SemanticSearchSchema, SemanticSearchEvent, Path<search_sv, semantic_sv>, Controller<SemanticSearchController>>;
+using SemanticSearchBatchRoute = Route<Verb::Post, SemanticSearchBatchSchema, SemanticSearchBatchEvent, Path<search_sv, semantic_sv, batch_sv>, Controller<SemanticSearchBatchController>>;
+using SemanticSearchPassagesRoute = Route<Verb::Post, SemanticSearchPassagesSchema, SemanticSearchPassagesEvent, Path<search_sv, semantic_sv, passages_sv>, Controller<SemanticSearchPassagesController>>;
+using SemanticSearchGlobalRoute = Route<Verb::Post, SemanticSearchGlobalSchema, SemanticSearchGlobalEvent, Path<search_sv, global_sv>, Controller<SemanticSearchGlobalController>>;
 
-using MQDispatcher = Dispatcher<ContainerCreateRoute, GetContainerFilesRoute, ContainerDeleteRoute, FileCreateRoute, FileDeleteRoute, ContainerStopRoute, SemanticSearchRoute>;
+using MQDispatcher = Dispatcher<ContainerCreateRoute, GetContainerFilesRoute, ContainerMetricsRoute, ContainerDeleteRoute, ContainerCloneRoute, FileCreateRoute, FileDeleteRoute, FileSearchRoute, BulkImportRoute, ContainerStopRoute, SemanticSearchRoute, SemanticSearchBatchRoute, SemanticSearchPassagesRoute, SemanticSearchGlobalRoute>;
 
 } // namespace owl
 
@@ -7,9 +7,8 @@ namespace owl {
 
 struct FileCreateController final : public Controller<FileCreateController> {
   template <typename Schema, typename Event>
-  auto operator()(const nlohmann::json &message) {
-    return this->validate<Event>(message).map(
-        [](const Event &ev) { return ev; });
+  auto operator()(nlohmann::json &message) {
+    return this->validate<Event>(message);
   }
 };
 
@@ -0,0 +1,18 @@
+#ifndef OWL_MQ_CONTROLLERS_FILE_SEARCH
+#define OWL_MQ_CONTROLLERS_FILE_SEARCH
+
+#include "vfs/mq/controller.hpp"
+
+namespace owl {
+
+struct FileSearchController final : public Controller<FileSearchController> {
+  template <typename Schema, typename Event>
+  auto operator()(const nlohmann::json &message) {
+    return this->validate<Event>(message).map(
+        [](const Event &ev) { return ev; });
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_MQ_CONTROLLERS_FILE_SEARCH
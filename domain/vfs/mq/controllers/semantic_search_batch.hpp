@@ -0,0 +1,18 @@
+#ifndef OWL_MQ_CONTROLLERS_SEMANTIC_SEARCH_BATCH
+#define OWL_MQ_CONTROLLERS_SEMANTIC_SEARCH_BATCH
+
+#include "vfs/mq/controller.hpp"
+
+namespace owl {
+
+struct SemanticSearchBatchController final : public Controller<SemanticSearchBatchController> {
+  template <typename Schema, typename Event>
+  auto operator()(const nlohmann::json &message) {
+    return this->validate<Event>(message).map(
+        [](const Event &ev) { return ev; });
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_MQ_CONTROLLERS_SEMANTIC_SEARCH_BATCH
\ No newline at end of file
@@ -0,0 +1,18 @@
+#ifndef OWL_MQ_CONTROLLERS_SEMANTIC_SEARCH_GLOBAL
+#define OWL_MQ_CONTROLLERS_SEMANTIC_SEARCH_GLOBAL
+
+#include "vfs/mq/controller.hpp"
+
+namespace owl {
+
+struct SemanticSearchGlobalController final : public Controller<SemanticSearchGlobalController> {
+  template <typename Schema, typename Event>
+  auto operator()(const nlohmann::json &message) {
+    return this->validate<Event>(message).map(
+        [](const Event &ev) { return ev; });
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_MQ_CONTROLLERS_SEMANTIC_SEARCH_GLOBAL
\ No newline at end of file
@@ -0,0 +1,18 @@
+#ifndef OWL_MQ_CONTROLLERS_SEMANTIC_SEARCH_PASSAGES
+#define OWL_MQ_CONTROLLERS_SEMANTIC_SEARCH_PASSAGES
+
+#include "vfs/mq/controller.hpp"
+
+namespace owl {
+
+struct SemanticSearchPassagesController final : public Controller<SemanticSearchPassagesController> {
+  template <typename Schema, typename Event>
+  auto operator()(const nlohmann::json &message) {
+    return this->validate<Event>(message).map(
+        [](const Event &ev) { return ev; });
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_MQ_CONTROLLERS_SEMANTIC_SEARCH_PASSAGES
\ No newline at end of file
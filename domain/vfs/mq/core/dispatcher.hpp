@@ -42,7 +42,9 @@ template <typename... Routes> class Dispatcher {
 public:
   explicit Dispatcher(State &state) : state_(state) {}
 
-  void dispatch(const Request &req) {
+  // Takes the request so that the matched controller may move fields out of
+  // its payload.
+  void dispatch(Request req) {
     auto segments = splitPath(req.path);
 
     bool handled = false;
@@ -60,8 +62,8 @@ private:
   State &state_;
 
   template <typename RouteT>
-  void tryRoute(const Request &req,
-                const std::vector<std::string_view> &segments, bool &handled) {
+  void tryRoute(Request &req, const std::vector<std::string_view> &segments,
+                bool &handled) {
     if (handled) {
       return;
     }
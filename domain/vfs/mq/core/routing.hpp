@@ -18,6 +18,12 @@ inline constexpr std::string_view delete_sv = "delete";
 inline constexpr std::string_view stop_sv = "stop";
 inline constexpr std::string_view rebuild_sv = "rebuild";
 inline constexpr std::string_view files_sv = "files";
+inline constexpr std::string_view metrics_sv = "metrics";
+inline constexpr std::string_view import_sv = "import";
+inline constexpr std::string_view clone_sv = "clone";
+inline constexpr std::string_view batch_sv = "batch";
+inline constexpr std::string_view passages_sv = "passages";
+inline constexpr std::string_view global_sv = "global";
 
 enum class Verb { Get, Post, Put, Delete };
 
@@ -14,14 +14,21 @@ static std::pair<Verb, std::string> mqmap(const std::string &verb_str) {
           {"container_create",                {Verb::Post, "container/create"}},
           {"get_container_files",             {Verb::Get, "container/files"}},
           {"get_container_files_and_rebuild", {Verb::Get, "container/files"}},
+          {"get_container_metrics",           {Verb::Get, "container/metrics"}},
           {"container_delete",                {Verb::Delete, "container/delete"}},
+          {"container_clone",                 {Verb::Post, "container/clone"}},
           {"file_create",                     {Verb::Post, "file/create"}},
           {"create_file",                     {Verb::Post, "file/create"}},
           {"file_delete",                     {Verb::Delete, "file/delete"}},
           {"delete_file",                     {Verb::Delete, "file/delete"}},
+          {"file_search",                     {Verb::Post, "file/search"}},
+          {"bulk_import",                     {Verb::Post, "file/import"}},
           {"container_stop",                  {Verb::Post, "container/stop"}},
           {"semantic_search_in_container",    {Verb::Post, "search/semantic"}},
-          {"semantic_search",                 {Verb::Post, "search/semantic"}}};
+          {"semantic_search",                 {Verb::Post, "search/semantic"}},
+          {"semantic_search_batch",           {Verb::Post, "search/semantic/batch"}},
+          {"semantic_search_passages",        {Verb::Post, "search/semantic/passages"}},
+          {"semantic_search_global",          {Verb::Post, "search/global"}}};
 
   auto it = routes.find(verb_str);
   return it != routes.end()
@@ -13,15 +13,13 @@ class MQObserver {
     using Base::Base;
 
     void operator()(const std::string &verb_str, const std::string &path_str,
-                    const nlohmann::json &msg) {
+                    nlohmann::json msg) {
+      std::string id = msg.value("request_id", "");
       try {
         auto [verb, path] = mqmap(verb_str);
-        Request req{verb, path, msg};
-
-        this->dispatcher_.dispatch(req);
+        this->dispatcher_.dispatch(Request{verb, path, std::move(msg)});
 
       } catch (const std::exception &e) {
-        std::string id = msg.value("request_id", "");
         this->loop_->sendResponse(id, false, {{"error", e.what()}});
         spdlog::error("MQ error: {}", e.what());
       }
@@ -31,9 +29,15 @@ class MQObserver {
 public:
   explicit MQObserver(State &state)
       : handler_(state, std::make_shared<TLoop>([this](auto v, auto p, auto m) {
-                   handler_(v, p, m);
+                   handler_(v, p, std::move(m));
                  })),
-        runner_(handler_.getLoop()) {}
+        runner_(handler_.getLoop()) {
+    state.events_.template Subscribe<MQResponseEvent>(
+        [this](const MQResponseEvent &response) {
+          handler_.getLoop()->sendResponse(response.request_id,
+                                           response.success, response.data);
+        });
+  }
 
   void start() { runner_.start("mq_listener"); }
   void stop() { runner_.stop(); }
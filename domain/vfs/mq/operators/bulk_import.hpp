@@ -0,0 +1,72 @@
+#ifndef OWL_VFS_CORE_OPERATORS_BULK_IMPORT
+#define OWL_VFS_CORE_OPERATORS_BULK_IMPORT
+
+#include "vfs/core/import/archive_reader.hpp"
+#include "vfs/mq/operators/resolvers/resolvers.hpp"
+
+namespace owl {
+
+// The import itself runs on the import pool, so neither the event loop nor
+// the searches on the worker pool wait while a large archive is ingested.
+// Sources must resolve to somewhere under the configured import root. Intermediate messages
+// carry "progress": true and share the request_id of the final response.
+template <typename EventSchema>
+struct BulkImport final
+    : FullContainerHandler<BulkImport<EventSchema>, EventSchema> {
+  using Base = FullContainerHandler<BulkImport<EventSchema>, EventSchema>;
+  using Base::Base;
+
+  void operator()(const EventSchema &e) {
+    this->process(e, [this](auto &s, auto &ev, auto c) {
+      const auto &config = s.import_config_;
+      const auto resolved = resolveImportSource(config.root, ev.source);
+      if (!resolved) {
+        return core::Result<std::string>::Error(std::runtime_error(
+            "import source must be under " + config.root.string() + ": " +
+            ev.source));
+      }
+      const auto source = *resolved;
+      if (!importSourceKind(source)) {
+        return core::Result<std::string>::Error(
+            std::runtime_error("unsupported import source: " + ev.source));
+      }
+
+      s.imports_.post([this, c, ev, source,
+                       max_entry_bytes = config.max_entry_bytes]() {
+        auto result = c->importFrom(
+            source, max_entry_bytes, [this, &ev](const auto &stats) {
+              auto data = toJson(stats);
+              data["progress"] = true;
+              this->respond(ev, true, std::move(data));
+            });
+
+        if (result.is_ok()) {
+          auto data = toJson(result.value());
+          data["container_id"] = ev.container_id;
+          this->respond(ev, true, std::move(data));
+        } else {
+          this->respond(ev, false, {{"error", result.error().what()}});
+        }
+      });
+
+      return core::Result<std::string>::Ok(ev.source);
+    });
+  }
+
+private:
+  static nlohmann::json toJson(const ImportStats &stats) {
+    return {{"written", stats.written},
+            {"indexed", stats.indexed},
+            {"failed", stats.failed},
+            {"bytes", stats.bytes},
+            {"elapsed_ms", stats.elapsed.count()}};
+  }
+
+  void onSuccess(const std::string &source) {
+    spdlog::info("Bulk import started from {}", source);
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_OPERATORS_BULK_IMPORT
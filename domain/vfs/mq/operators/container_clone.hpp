@@ -0,0 +1,91 @@
+#ifndef OWL_VFS_CORE_OPERATORS_CONTAINER_CLONE
+#define OWL_VFS_CORE_OPERATORS_CONTAINER_CLONE
+
+#include "vfs/core/container/clone.hpp"
+#include "vfs/mq/operators/resolvers/resolvers.hpp"
+
+namespace owl {
+
+// Clones share data blocks with the source (reflink, else a copy) and start
+// from its vector snapshot, so they are searchable as soon as they are
+// registered; chunkees is fed in the background.
+template <typename EventSchema>
+struct ContainerClone final
+    : CloneContainerHandler<ContainerClone<EventSchema>, EventSchema> {
+  using Base = CloneContainerHandler<ContainerClone<EventSchema>, EventSchema>;
+  using Base::Base;
+
+  void operator()(const EventSchema &e) {
+    this->process(e, [this](auto &s, auto &ev, auto source) {
+      using Error = std::runtime_error;
+      const auto started = std::chrono::steady_clock::now();
+
+      if (ev.target_id.empty() || ev.target_id.find('/') != std::string::npos ||
+          s.container_manager_.contains(ev.target_id)) {
+        return core::Result<std::string>::Error(
+            Error("Invalid or existing clone target: " + ev.target_id));
+      }
+
+      source->persistVectorIndex();
+
+      const auto target = fs::path(kBaseContainerPath) / ev.target_id;
+      auto cloned = cloneTree(source->getDataPath(), target);
+      if (!cloned.is_ok()) {
+        return core::Result<std::string>::Error(cloned.error());
+      }
+
+      try {
+        const auto config_path = target / "container_config.json";
+        auto config = readJsonFile(config_path.string());
+        config["owner"] = ev.user_id;
+        config["status"] = "stopped";
+        if (config.value("type", "") == "template") {
+          config["type"] = "default";
+        }
+        writeFileAtomically(config_path, config.dump(2));
+
+        FSProcessor processor(kBaseContainerPath);
+        auto native = std::make_shared<ossec::PidContainer>(
+            processor.loadContainer(target.string()));
+
+        auto registered = s.container_manager_.createAndRegisterContainer(
+            std::move(native), kModelPath, SearchWarmup::Deferred,
+            &s.residency_);
+        if (!registered.is_ok()) {
+          throw Error(registered.error().what());
+        }
+      } catch (const std::exception &error) {
+        std::error_code ec;
+        fs::remove_all(target, ec);
+        return core::Result<std::string>::Error(
+            Error(std::string("clone failed: ") + error.what()));
+      }
+
+      auto clone = s.container_manager_.getContainer(ev.target_id).value();
+      s.workers_.post([clone]() { clone->warmSearch(); });
+
+      const auto &stats = cloned.value();
+      this->respond(
+          ev, true,
+          {{"container_id", ev.target_id},
+           {"source_id", ev.container_id},
+           {"reflinked", stats.reflinked},
+           {"copied", stats.copied},
+           {"vectors", clone->vectors().snapshot()->size()},
+           {"elapsed_ms", std::chrono::duration_cast<std::chrono::milliseconds>(
+                              std::chrono::steady_clock::now() - started)
+                              .count()}});
+
+      return core::Result<std::string>::Ok(ev.target_id);
+    });
+  }
+
+private:
+  void onSuccess(const std::string &target_id) {
+    spdlog::info("Container cloned: {}", target_id);
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_OPERATORS_CONTAINER_CLONE
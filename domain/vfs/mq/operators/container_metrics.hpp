@@ -0,0 +1,66 @@
+#ifndef OWL_VFS_CORE_OPERATORS_CONTAINER_METRICS
+#define OWL_VFS_CORE_OPERATORS_CONTAINER_METRICS
+
+#include "vfs/mq/operators/resolvers/resolvers.hpp"
+
+namespace owl {
+
+// Answers from the sampler's last pass; never reads the cgroup itself.
+template <typename EventSchema>
+struct ContainerMetrics final
+    : ExistingContainerHandler<ContainerMetrics<EventSchema>, EventSchema> {
+  using Base =
+      ExistingContainerHandler<ContainerMetrics<EventSchema>, EventSchema>;
+  using Base::Base;
+
+  void operator()(const EventSchema &e) {
+    this->process(e, [this](auto &s, auto &ev, auto c) {
+      using Error = std::runtime_error;
+
+      auto sampled = s.metrics_.find(ev.container_id);
+      if (!sampled) {
+        return core::Result<bool>::Error(
+            Error("No cgroup metrics for container: " + ev.container_id));
+      }
+
+      const auto &m = *sampled;
+      this->respond(
+          ev, true,
+          {{"container_id", ev.container_id},
+           {"sampled_at_ms", m.sampled_at_ms},
+           {"interval_ms",
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                s.metrics_.interval())
+                .count()},
+           {"memory_limit", m.memory_limit},
+           {"cpu_limit", m.cpu_limit},
+           {"memory",
+            {{"current", m.memory_current},
+             {"max", m.memory_limit},
+             {"anon", m.memory_anon},
+             {"file", m.memory_file},
+             {"kernel", m.memory_kernel},
+             {"shmem", m.memory_shmem}}},
+           {"cpu",
+            {{"usage_usec", m.cpu_usage_usec},
+             {"user_usec", m.cpu_user_usec},
+             {"system_usec", m.cpu_system_usec},
+             {"nr_throttled", m.cpu_nr_throttled},
+             {"throttled_usec", m.cpu_throttled_usec},
+             {"limit", m.cpu_limit},
+             {"percent", m.cpu_percent}}},
+           {"io",
+            {{"read_bytes", m.io_read_bytes},
+             {"write_bytes", m.io_write_bytes},
+             {"read_ops", m.io_read_ops},
+             {"write_ops", m.io_write_ops}}},
+           {"pids", {{"current", m.pids_current}}}});
+
+      return core::Result<bool>::Ok(true);
+    });
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_OPERATORS_CONTAINER_METRICS
@@ -1,23 +1,38 @@
 #ifndef OWL_MQ_OPERATORS_EVENT_HANDLERS
 #define OWL_MQ_OPERATORS_EVENT_HANDLERS
 
+#include "vfs/mq/operators/bulk_import.hpp"
+#include "vfs/mq/operators/container_clone.hpp"
+#include "vfs/mq/operators/container_metrics.hpp"
 #include "vfs/mq/operators/container_stop.hpp"
 #include "vfs/mq/operators/create_container.hpp"
 #include "vfs/mq/operators/delete_container.hpp"
 #include "vfs/mq/operators/file_create.hpp"
 #include "vfs/mq/operators/file_delete.hpp"
+#include "vfs/mq/operators/file_search.hpp"
 #include "vfs/mq/operators/get_container_files.hpp"
+#include "vfs/mq/operators/semantic_search.hpp"
+#include "vfs/mq/operators/semantic_search_batch.hpp"
+#include "vfs/mq/operators/semantic_search_passages.hpp"
+#include "vfs/mq/operators/semantic_search_global.hpp"
 #include "vfs/core/schemas/events.hpp"
 
 namespace owl {
 
 using Operators =
     EventHandlers<GetContainerFiles<GetContainerFilesEvent>,
-                  GetContainerFiles<SemanticSearchEvent>,
+                  ContainerMetrics<ContainerMetricsEvent>,
+                  SemanticSearch<SemanticSearchEvent>,
+                  SemanticSearchBatch<SemanticSearchBatchEvent>,
+                  SemanticSearchPassages<SemanticSearchPassagesEvent>,
+                  SemanticSearchGlobal<SemanticSearchGlobalEvent>,
                   CreateContainer<ContainerCreateEvent>,
                   DeleteContainer<ContainerDeleteEvent>,
+                  ContainerClone<ContainerCloneEvent>,
                   FileCreate<FileCreateEvent>, 
                   FileDelete<FileDeleteEvent>,
+                  FileSearch<FileSearchEvent>,
+                  BulkImport<BulkImportEvent>,
                   ContainerStop<ContainerStopEvent>>;
                   
 }
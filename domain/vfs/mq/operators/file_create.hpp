@@ -10,14 +10,22 @@ struct FileCreate final : CreateFileHandler<FileCreate<EventSchema>, EventSchema
   using Base = CreateFileHandler<FileCreate<EventSchema>, EventSchema>;
   using Base::Base;
 
+  // Writes the content from the buffer the request was parsed into.
   void operator()(const auto &e) {
-    this->process(e, [this](auto &, auto &, auto c) {
+    this->process(e, [this](auto &, auto &ev, auto c) {
+      auto written = c->addFile(ev.path, *ev.content);
+      if (!written.is_ok()) {
+        return core::Result<bool>::Error(written.error());
+      }
+
+      this->respond(ev, true,
+                    {{"path", ev.path}, {"size", ev.content.size()}});
       return core::Result<bool>::Ok(true);
     });
   }
 
 private:
-  void onSuccess(bool result) { spdlog::info("Delete success: {}", result); }
+  void onSuccess(bool result) { spdlog::info("Create success: {}", result); }
 };
 
 } // namespace owl
@@ -0,0 +1,75 @@
+#ifndef OWL_VFS_CORE_OPERATORS_FILE_SEARCH
+#define OWL_VFS_CORE_OPERATORS_FILE_SEARCH
+
+#include <chrono>
+#include <future>
+
+#include "vfs/mq/operators/resolvers/resolvers.hpp"
+
+namespace owl {
+
+// Matches the pattern in every container the user owns on the worker pool.
+// As with global search, containers that miss the deadline are reported in
+// "timed_out" and the response is marked partial.
+template <typename EventSchema>
+struct FileSearch final
+    : UserContainersHandler<FileSearch<EventSchema>, EventSchema> {
+  using Base = UserContainersHandler<FileSearch<EventSchema>, EventSchema>;
+  using Base::Base;
+
+  static constexpr int kDefaultDeadlineMs = 250;
+
+  void operator()(const EventSchema &e) {
+    this->process(e, [this](auto &s, auto &ev, auto containers) {
+      const auto deadline =
+          std::chrono::steady_clock::now() +
+          std::chrono::milliseconds(ev.timeout_ms.value_or(kDefaultDeadlineMs));
+
+      std::vector<std::future<nlohmann::json>> pending;
+      pending.reserve(containers.size());
+
+      for (auto &container : containers) {
+        pending.push_back(
+            s.workers_.submit([container, pattern = ev.pattern]() {
+              auto files = container->searchFiles(pattern);
+              return nlohmann::json{
+                  {"container_id", container->getId()},
+                  {"files", files.is_ok() ? files.value()
+                                          : std::vector<std::string>{}}};
+            }));
+      }
+
+      auto results = nlohmann::json::array();
+      auto timed_out = nlohmann::json::array();
+      std::size_t count = 0;
+      for (std::size_t i = 0; i < pending.size(); ++i) {
+        if (pending[i].wait_until(deadline) != std::future_status::ready) {
+          timed_out.push_back(containers[i]->getId());
+          continue;
+        }
+        auto entry = pending[i].get();
+        count += entry["files"].size();
+        results.push_back(std::move(entry));
+      }
+
+      const bool partial = !timed_out.empty();
+      this->respond(ev, true,
+                    {{"pattern", ev.pattern},
+                     {"results", std::move(results)},
+                     {"count", count},
+                     {"timed_out", std::move(timed_out)},
+                     {"partial", partial}});
+
+      return core::Result<std::size_t>::Ok(count);
+    });
+  }
+
+private:
+  void onSuccess(std::size_t count) {
+    spdlog::info("File search matched {} files", count);
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_OPERATORS_FILE_SEARCH
@@ -5,10 +5,11 @@
 
 namespace owl {
 
+// A hibernated container passes: the handler's first pin wakes it.
 template <typename State, typename Event> struct ContainerIsActive {
   auto operator()(State &, const OssecContainerPtr &container,
                   const Event &) const -> Result<void, std::runtime_error> {
-    if (!container->isAvailable()) {
+    if (!container->isAvailable() && !container->isHibernated()) {
       return Result<void, std::runtime_error>::Error(
           std::runtime_error("OssecContainer<> is not active"));
     }
@@ -0,0 +1,30 @@
+#ifndef OWL_MQ_OPERATORS_RESOLVERS_CHECK_CONTAINER_CLONEABLE
+#define OWL_MQ_OPERATORS_RESOLVERS_CHECK_CONTAINER_CLONEABLE
+
+#include "vfs/mq/operators/resolvers/resolver.hpp"
+
+namespace owl {
+
+// Owners can clone their own containers; anyone can clone a container
+// labelled type=template.
+template <typename State, typename Event> struct ContainerCloneable {
+  auto operator()(State &state, const OssecContainerPtr &container,
+                  const Event &event) const -> Result<void> {
+    if (container->getOwner() == event.user_id) {
+      return Result<void>::Ok();
+    }
+
+    const auto labels = container->getLabels();
+    const auto type = labels.find("type");
+    if (type != labels.end() && type->second == "template") {
+      return Result<void>::Ok();
+    }
+
+    return Result<void>::Error(
+        std::runtime_error("Access denied for user: " + event.user_id));
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_MQ_OPERATORS_RESOLVERS_CHECK_CONTAINER_CLONEABLE
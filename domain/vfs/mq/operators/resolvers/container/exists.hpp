@@ -5,9 +5,17 @@
 
 namespace owl {
 
+// A container that is still loading is reported as such rather than
+// missing. EventHandlers holds queued requests back until it is ready, so
+// this only sees the ones that are refused.
 template <typename State, typename Event> struct ContainerExists final {
   auto operator()(State &state,
                   const Event &event) const -> Result<OssecContainerPtr> {
+    if (state.loader_.isLoading(event.container_id)) {
+      return Result<OssecContainerPtr>::Error(
+          std::runtime_error("Container is loading: " + event.container_id));
+    }
+
     auto container = state.container_manager_.getContainer(event.container_id);
 
     if (!container.is_ok()) {
@@ -23,7 +31,7 @@ template <typename State, typename Event> struct ContainerNotExists {
   auto operator()(State &state, const Event &event) const -> Result<bool> {
     auto container = state.container_manager_.getContainer(event.container_id);
 
-    if (container.is_ok()) {
+    if (container.is_ok() || state.loader_.isLoading(event.container_id)) {
       return Result<bool>::Error(std::runtime_error(
           "Container already exists: " + event.container_id));
     }
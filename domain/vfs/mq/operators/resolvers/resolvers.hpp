@@ -3,11 +3,14 @@
 
 #include "vfs/core/handlers.hpp"
 #include "vfs/core/container/ossec_container.hpp"
+#include "vfs/core/schemas/events.hpp"
 #include "vfs/mq/operators/resolvers/container/active.hpp"
+#include "vfs/mq/operators/resolvers/container/cloneable.hpp"
 #include "vfs/mq/operators/resolvers/container/exists.hpp"
 #include "vfs/mq/operators/resolvers/container/ownership.hpp"
 #include "vfs/mq/operators/resolvers/file/exists.hpp"
 #include "vfs/mq/operators/resolvers/resolver.hpp"
+#include "vfs/mq/operators/resolvers/user/containers.hpp"
 
 namespace owl {
 
@@ -30,9 +33,22 @@ protected:
 
     handleResult(result);
 
+    if (!result.is_ok()) {
+      respond(event, false, {{"error", result.error().what()}});
+    }
+
     return result;
   }
 
+  void respond(const EventSchema &event, bool success, nlohmann::json data) {
+    MQResponseEvent response;
+    response.request_id = event.request_id;
+    response.success = success;
+    response.data = std::move(data);
+
+    this->state_.events_.template Notify<MQResponseEvent>(std::move(response));
+  }
+
 private:
   friend Derived;
 
@@ -92,6 +108,12 @@ using CreateContainerHandler = ContainerHandlerImpl<Derived, EventSchema, bool,
 template <typename Derived, typename EventSchema>
 using CreateFileHandler = ContainerHandlerImpl<Derived, EventSchema, OssecContainerPtr, ContainerExists<State, EventSchema>, ContainerOwnership<State, EventSchema>, ContainerIsActive<State, EventSchema>, FileNotExists<State, EventSchema>>;
 
+template <typename Derived, typename EventSchema>
+using CloneContainerHandler = ContainerHandlerImpl<Derived, EventSchema, OssecContainerPtr, ContainerExists<State, EventSchema>, ContainerCloneable<State, EventSchema>>;
+
+template <typename Derived, typename EventSchema>
+using UserContainersHandler = ContainerHandlerImpl<Derived, EventSchema, std::vector<OssecContainerPtr>, UserContainers<State, EventSchema>>;
+
 template <typename Derived, typename EventSchema>
 using DeleteFileHandler = ContainerHandlerImpl<Derived, EventSchema, OssecContainerPtr, ContainerExists<State, EventSchema>, ContainerOwnership<State, EventSchema>, ContainerIsActive<State, EventSchema>, FileExists<State, EventSchema>>;
 
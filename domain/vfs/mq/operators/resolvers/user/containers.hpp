@@ -0,0 +1,25 @@
+#ifndef OWL_MQ_OPERATORS_RESOLVERS_USER_CONTAINERS
+#define OWL_MQ_OPERATORS_RESOLVERS_USER_CONTAINERS
+
+#include "vfs/mq/operators/resolvers/resolver.hpp"
+
+namespace owl {
+
+template <typename State, typename Event> struct UserContainers final {
+  auto operator()(State &state, const Event &event) const
+      -> Result<std::vector<OssecContainerPtr>> {
+    auto containers =
+        state.container_manager_.getContainersByOwner(event.user_id);
+
+    if (containers.empty()) {
+      return Result<std::vector<OssecContainerPtr>>::Error(
+          std::runtime_error("No containers for user: " + event.user_id));
+    }
+
+    return Result<std::vector<OssecContainerPtr>>::Ok(std::move(containers));
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_MQ_OPERATORS_RESOLVERS_USER_CONTAINERS
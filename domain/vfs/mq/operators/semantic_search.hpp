@@ -0,0 +1,102 @@
+#ifndef OWL_VFS_CORE_OPERATORS_SEMANTIC_SEARCH
+#define OWL_VFS_CORE_OPERATORS_SEMANTIC_SEARCH
+
+#include "vfs/core/index/embedding.hpp"
+#include "vfs/core/index/query_cache.hpp"
+#include "vfs/core/index/rank_fusion.hpp"
+#include "vfs/core/index/search_filter.hpp"
+#include "vfs/mq/operators/resolvers/resolvers.hpp"
+
+namespace owl {
+
+template <typename EventSchema>
+struct SemanticSearch final
+    : ExistingContainerHandler<SemanticSearch<EventSchema>, EventSchema> {
+  using Base =
+      ExistingContainerHandler<SemanticSearch<EventSchema>, EventSchema>;
+  using Base::Base;
+
+  void operator()(const EventSchema &e) {
+    this->process(e, [this](auto &s, auto &ev, auto c) {
+      const auto mode = parseSearchMode(ev.mode.value_or("semantic"));
+      const auto query = normalizeQuery(ev.query);
+
+      // Read the generation before searching: if a write lands meanwhile the
+      // result is filed under the old generation and never served again.
+      const VectorSearchParams tuning{ev.nprobe.value_or(0),
+                                      ev.ef_search.value_or(0)};
+      const auto filter = searchFilter(ev);
+      ResultCacheKey key{ev.container_id, c->searchGeneration(), mode, query,
+                         ev.limit, tuning, filter.key()};
+
+      auto hits = s.query_cache_.results(key);
+      const bool cached = hits.has_value();
+      if (!cached) {
+        QueryCache::Vector embedding;
+        if (mode != SearchMode::Keyword) {
+          auto embedded = s.query_cache_.embedding(query, [&]() {
+            const auto pin = c->pinIndex();
+            return embedText(c->embedder(), query);
+          });
+          if (embedded.is_ok()) {
+            embedding = std::move(embedded.value());
+          }
+        }
+
+        auto found = c->searchWithMode(query, ev.limit, mode,
+                                       {embedding.get(), tuning, filter});
+        if (!found.is_ok()) {
+          return core::Result<std::size_t>::Error(found.error());
+        }
+        hits = s.query_cache_.storeResults(std::move(key),
+                                           std::move(found.value()));
+      }
+
+      auto results = nlohmann::json::array();
+      for (const auto &[path, score] : **hits) {
+        results.push_back({{"path", path}, {"score", score}});
+      }
+
+      const auto embeddings = s.query_cache_.embeddingStats();
+      const auto stored = s.query_cache_.resultStats();
+      const auto count = results.size();
+      this->respond(ev, true,
+                    {{"query", ev.query},
+                     {"container_id", ev.container_id},
+                     {"mode", ev.mode.value_or("semantic")},
+                     {"results", std::move(results)},
+                     {"count", count},
+                     {"cached", cached},
+                     {"cache",
+                      {{"embedding_hit_rate", embeddings.hitRate()},
+                       {"embedding_entries", embeddings.entries},
+                       {"result_hit_rate", stored.hitRate()},
+                       {"result_entries", stored.entries}}}});
+
+      return core::Result<std::size_t>::Ok(count);
+    });
+  }
+
+private:
+  static SearchFilter searchFilter(const EventSchema &ev) {
+    SearchFilter filter;
+    filter.path_prefix = ev.path_prefix.value_or("");
+    filter.category = ev.category;
+    if (ev.mtime_from) {
+      filter.mtime_from = static_cast<std::int64_t>(*ev.mtime_from);
+    }
+    if (ev.mtime_to) {
+      filter.mtime_to = static_cast<std::int64_t>(*ev.mtime_to);
+    }
+    filter.labels = ev.labels.value_or(std::vector<std::string>{});
+    return filter;
+  }
+
+  void onSuccess(std::size_t count) {
+    spdlog::info("Search returned {} results", count);
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_OPERATORS_SEMANTIC_SEARCH
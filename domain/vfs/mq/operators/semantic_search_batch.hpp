@@ -0,0 +1,110 @@
+#ifndef OWL_VFS_CORE_OPERATORS_SEMANTIC_SEARCH_BATCH
+#define OWL_VFS_CORE_OPERATORS_SEMANTIC_SEARCH_BATCH
+
+#include "vfs/core/index/embedding.hpp"
+#include "vfs/core/index/query_cache.hpp"
+#include "vfs/mq/operators/resolvers/resolvers.hpp"
+
+namespace owl {
+
+// Answers what it can from the result cache and sends the remaining queries
+// to the container as a single batched vector search. Results for queries
+// that could not be embedded came from a fallback and are not cached.
+template <typename EventSchema>
+struct SemanticSearchBatch final
+    : ExistingContainerHandler<SemanticSearchBatch<EventSchema>, EventSchema> {
+  using Base =
+      ExistingContainerHandler<SemanticSearchBatch<EventSchema>, EventSchema>;
+  using Base::Base;
+
+  static constexpr std::size_t kMaxBatchQueries = 256;
+
+  void operator()(const EventSchema &e) {
+    this->process(e, [this](auto &s, auto &ev, auto c) {
+      using Error = std::runtime_error;
+
+      if (ev.queries.empty() || ev.queries.size() > kMaxBatchQueries) {
+        return core::Result<std::size_t>::Error(
+            Error("queries must hold 1.." + std::to_string(kMaxBatchQueries) +
+                  " entries"));
+      }
+
+      const auto generation = c->searchGeneration();
+      const VectorSearchParams tuning{ev.nprobe.value_or(0),
+                                      ev.ef_search.value_or(0)};
+      std::vector<QueryCache::HitsPtr> answers(ev.queries.size());
+
+      std::vector<std::size_t> pending;
+      std::vector<ResultCacheKey> keys;
+      std::vector<std::string> queries;
+      std::vector<QueryCache::Vector> embeddings;
+      for (std::size_t i = 0; i < ev.queries.size(); ++i) {
+        ResultCacheKey key{ev.container_id, generation, SearchMode::Semantic,
+                           normalizeQuery(ev.queries[i]), ev.limit, tuning};
+        if (auto cached = s.query_cache_.results(key)) {
+          answers[i] = std::move(*cached);
+          continue;
+        }
+
+        auto embedded = s.query_cache_.embedding(key.query, [&]() {
+          const auto pin = c->pinIndex();
+          return embedText(c->embedder(), key.query);
+        });
+        embeddings.push_back(embedded.is_ok() ? embedded.value() : nullptr);
+        queries.push_back(key.query);
+        keys.push_back(std::move(key));
+        pending.push_back(i);
+      }
+
+      if (!pending.empty()) {
+        std::vector<const std::vector<float> *> vectors;
+        vectors.reserve(embeddings.size());
+        for (const auto &embedding : embeddings) {
+          vectors.push_back(embedding.get());
+        }
+
+        auto found =
+            c->semanticSearchBatch(queries, ev.limit, vectors, tuning);
+        if (!found.is_ok()) {
+          return core::Result<std::size_t>::Error(found.error());
+        }
+        for (std::size_t j = 0; j < pending.size(); ++j) {
+          auto &hits = found.value()[j];
+          answers[pending[j]] =
+              embeddings[j] ? s.query_cache_.storeResults(std::move(keys[j]),
+                                                          std::move(hits))
+                            : std::make_shared<const QueryCache::Hits>(
+                                  std::move(hits));
+        }
+      }
+
+      auto results = nlohmann::json::array();
+      for (std::size_t i = 0; i < answers.size(); ++i) {
+        auto hits = nlohmann::json::array();
+        for (const auto &[path, score] : *answers[i]) {
+          hits.push_back({{"path", path}, {"score", score}});
+        }
+        results.push_back({{"query", ev.queries[i]},
+                           {"results", std::move(hits)},
+                           {"count", answers[i]->size()}});
+      }
+
+      this->respond(ev, true,
+                    {{"container_id", ev.container_id},
+                     {"results", std::move(results)},
+                     {"count", ev.queries.size()},
+                     {"cached", ev.queries.size() - pending.size()}});
+
+      return core::Result<std::size_t>::Ok(ev.queries.size());
+    });
+  }
+
+private:
+  void onSuccess(std::size_t count) {
+    spdlog::info("Batch search answered {} queries", count);
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_OPERATORS_SEMANTIC_SEARCH_BATCH
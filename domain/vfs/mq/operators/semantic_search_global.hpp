@@ -0,0 +1,150 @@
+#ifndef OWL_VFS_CORE_OPERATORS_SEMANTIC_SEARCH_GLOBAL
+#define OWL_VFS_CORE_OPERATORS_SEMANTIC_SEARCH_GLOBAL
+
+#include <chrono>
+#include <future>
+
+#include "vfs/core/index/embedding.hpp"
+#include "vfs/core/index/query_cache.hpp"
+#include "vfs/core/index/rank_fusion.hpp"
+#include "vfs/core/index/top_k.hpp"
+#include "vfs/mq/operators/resolvers/resolvers.hpp"
+
+namespace owl {
+
+// Fans the query out to every container the user owns on the worker pool and
+// merges the per-container top-k lists. Cosine scores from the one embedder
+// compare across containers and are merged as they are; BM25 and fused
+// scores depend on each container's corpus, so those lists are merged by
+// rank with RRF instead. Only containers whose index is already resident are
+// searched: the rest are reported in "skipped" rather than loaded or woken
+// for one query. Containers that miss the deadline are reported in
+// "timed_out"; either marks the response partial. Late searches finish in
+// the background and are dropped.
+template <typename EventSchema>
+struct SemanticSearchGlobal final
+    : UserContainersHandler<SemanticSearchGlobal<EventSchema>, EventSchema> {
+  using Base =
+      UserContainersHandler<SemanticSearchGlobal<EventSchema>, EventSchema>;
+  using Base::Base;
+
+  static constexpr int kDefaultDeadlineMs = 250;
+  static constexpr int kMaxLimit = 1000;
+
+  void operator()(const EventSchema &e) {
+    this->process(e, [this](auto &s, auto &ev, auto containers) {
+      using Hits = std::vector<std::pair<std::string, float>>;
+      using Error = std::runtime_error;
+
+      const auto mode = parseSearchMode(ev.mode.value_or("semantic"));
+      const auto query = normalizeQuery(ev.query);
+      const auto limit = std::clamp(ev.limit, 0, kMaxLimit);
+      const bool by_rank = mode != SearchMode::Semantic;
+      const auto deadline =
+          std::chrono::steady_clock::now() +
+          std::chrono::milliseconds(ev.timeout_ms.value_or(kDefaultDeadlineMs));
+
+      // Embedded once here, with the shared model, rather than by a container.
+      QueryCache::Vector embedding;
+      if (mode != SearchMode::Keyword) {
+        auto embedded = s.query_cache_.embedding(
+            query, [&]() { return embedText(s.global_embedder_, query); });
+        if (embedded.is_ok()) {
+          embedding = std::move(embedded.value());
+        }
+      }
+
+      // Pinned here so that none of them is evicted before its worker runs.
+      decltype(containers) searched;
+      std::vector<std::future<core::Result<Hits>>> pending;
+      auto skipped = nlohmann::json::array();
+      searched.reserve(containers.size());
+      pending.reserve(containers.size());
+      for (auto &container : containers) {
+        auto pin = container->pinIfResident();
+        if (!pin) {
+          skipped.push_back(container->getId());
+          continue;
+        }
+        searched.push_back(container);
+        pending.push_back(s.workers_.submit(
+            [container, pin = std::move(*pin), query, limit, mode,
+             embedding]() {
+              return container->searchWithMode(query, limit, mode,
+                                               {embedding.get()});
+            }));
+      }
+
+      // Items are (index into `owners`, path).
+      TopK<std::pair<std::size_t, std::string>> top(
+          static_cast<std::size_t>(limit));
+      auto timed_out = nlohmann::json::array();
+      auto failed = nlohmann::json::array();
+      std::vector<std::string> owners;
+      owners.reserve(searched.size());
+
+      for (std::size_t i = 0; i < pending.size(); ++i) {
+        const auto id = searched[i]->getId();
+        if (pending[i].wait_until(deadline) != std::future_status::ready) {
+          timed_out.push_back(id);
+          continue;
+        }
+
+        auto found = pending[i].get();
+        if (!found.is_ok()) {
+          spdlog::warn("Global search in {} failed: {}", id,
+                       found.error().what());
+          failed.push_back(id);
+          continue;
+        }
+
+        const auto owner = owners.size();
+        owners.push_back(id);
+        auto &hits = found.value();
+        for (std::size_t rank = 0; rank < hits.size(); ++rank) {
+          auto &[path, score] = hits[rank];
+          top.push({owner, std::move(path)},
+                   by_rank ? reciprocalRank(rank) : score);
+        }
+      }
+
+      auto results = nlohmann::json::array();
+      for (auto &[score, hit] : top.take()) {
+        results.push_back({{"container_id", owners[hit.first]},
+                           {"path", std::move(hit.second)},
+                           {"score", score}});
+      }
+
+      if (!searched.empty() && failed.size() == searched.size()) {
+        return core::Result<std::size_t>::Error(
+            Error("search failed in every container"));
+      }
+
+      const auto count = results.size();
+      const bool partial =
+          !timed_out.empty() || !failed.empty() || !skipped.empty();
+      this->respond(ev, true,
+                    {{"query", ev.query},
+                     {"mode", ev.mode.value_or("semantic")},
+                     {"ranked_by", by_rank ? "rank" : "score"},
+                     {"results", std::move(results)},
+                     {"count", count},
+                     {"containers", containers.size()},
+                     {"skipped", std::move(skipped)},
+                     {"timed_out", std::move(timed_out)},
+                     {"failed", std::move(failed)},
+                     {"partial", partial}});
+
+      return core::Result<std::size_t>::Ok(count);
+    });
+  }
+
+private:
+  void onSuccess(std::size_t count) {
+    spdlog::info("Global search returned {} results", count);
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_OPERATORS_SEMANTIC_SEARCH_GLOBAL
@@ -0,0 +1,64 @@
+#ifndef OWL_VFS_CORE_OPERATORS_SEMANTIC_SEARCH_PASSAGES
+#define OWL_VFS_CORE_OPERATORS_SEMANTIC_SEARCH_PASSAGES
+
+#include "vfs/core/index/embedding.hpp"
+#include "vfs/core/index/query_cache.hpp"
+#include "vfs/mq/operators/resolvers/resolvers.hpp"
+
+namespace owl {
+
+template <typename EventSchema>
+struct SemanticSearchPassages final
+    : ExistingContainerHandler<SemanticSearchPassages<EventSchema>,
+                               EventSchema> {
+  using Base = ExistingContainerHandler<SemanticSearchPassages<EventSchema>,
+                                        EventSchema>;
+  using Base::Base;
+
+  void operator()(const EventSchema &e) {
+    this->process(e, [this](auto &s, auto &ev, auto c) {
+      const auto query = normalizeQuery(ev.query);
+      auto embedded = s.query_cache_.embedding(query, [&]() {
+        const auto pin = c->pinIndex();
+        return embedText(c->embedder(), query);
+      });
+      if (!embedded.is_ok()) {
+        return core::Result<std::size_t>::Error(embedded.error());
+      }
+
+      const VectorSearchParams tuning{ev.nprobe.value_or(0),
+                                      ev.ef_search.value_or(0)};
+      auto found = c->passageSearch(query, ev.limit,
+                                    {embedded.value().get(), tuning});
+      if (!found.is_ok()) {
+        return core::Result<std::size_t>::Error(found.error());
+      }
+
+      auto results = nlohmann::json::array();
+      for (const auto &hit : found.value()) {
+        results.push_back({{"path", hit.path},
+                           {"offset", hit.offset},
+                           {"length", hit.length},
+                           {"score", hit.score}});
+      }
+
+      const auto count = results.size();
+      this->respond(ev, true,
+                    {{"query", ev.query},
+                     {"container_id", ev.container_id},
+                     {"results", std::move(results)},
+                     {"count", count}});
+
+      return core::Result<std::size_t>::Ok(count);
+    });
+  }
+
+private:
+  void onSuccess(std::size_t count) {
+    spdlog::info("Passage search returned {} results", count);
+  }
+};
+
+} // namespace owl
+
+#endif // OWL_VFS_CORE_OPERATORS_SEMANTIC_SEARCH_PASSAGES
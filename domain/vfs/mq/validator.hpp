@@ -6,15 +6,24 @@
 #include <boost/hana/functional.hpp>
 #include <infrastructure/result.hpp>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <spdlog/spdlog.h>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "vfs/core/schemas/payload.hpp"
+
 namespace owl {
+
+template <typename T> struct is_optional : std::false_type {};
+template <typename T> struct is_optional<std::optional<T>> : std::true_type {};
+
+// Given a mutable message, Payload fields take their string out of it instead
+// of copying; the rest of the message is left as it was.
 template <typename Derived> class Validator {
 public:
-  template <typename Schema> static auto validate(const nlohmann::json &json) {
+  template <typename Schema, typename Json> static auto validate(Json &json) {
     Schema obj;
     bool success = boost::hana::unpack(
         boost::hana::accessors<Schema>(), [&](auto &&...accessor) {
@@ -29,28 +38,56 @@ public:
   }
 
 protected:
-  template <typename Schema, typename Accessor>
-  static bool validateField(const nlohmann::json &body, Accessor accessor,
-                            Schema &obj) {
+  template <typename Json, typename Schema, typename Accessor>
+  static bool validateField(Json &body, Accessor accessor, Schema &obj) {
     auto name = hana::first(accessor);
     auto member_ptr = hana::second(accessor);
     std::string field_name = hana::to<char const *>(name);
+    auto &member = member_ptr(obj);
 
     if (!body.contains(field_name)) {
+      if constexpr (is_optional<std::decay_t<decltype(member)>>::value) {
+        return true;
+      }
       spdlog::error("Missing field: {}", field_name);
       return false;
     }
 
-    return validateValue(body[field_name], member_ptr(obj));
+    return validateValue(body[field_name], member);
+  }
+
+  static bool validateValue(nlohmann::json &json_value, Payload &member_ref) {
+    if (!json_value.is_string()) {
+      spdlog::error("Type mismatch for value, expected: string");
+      return false;
+    }
+    member_ref = Payload(std::move(json_value.get_ref<std::string &>()));
+    return true;
   }
 
   template <typename U>
   static bool validateValue(const nlohmann::json &json_value, U &member_ref) {
-    if constexpr (std::is_same_v<U, std::string>) {
+    if constexpr (is_optional<U>::value) {
+      if (json_value.is_null()) {
+        member_ref.reset();
+        return true;
+      }
+      typename U::value_type value{};
+      if (!validateValue(json_value, value)) {
+        return false;
+      }
+      member_ref = std::move(value);
+      return true;
+    } else if constexpr (std::is_same_v<U, std::string>) {
       if (json_value.is_string()) {
         member_ref = json_value.get<std::string>();
         return true;
       }
+    } else if constexpr (std::is_same_v<U, Payload>) {
+      if (json_value.is_string()) {
+        member_ref = Payload(json_value.get<std::string>());
+        return true;
+      }
     } else if constexpr (std::is_same_v<U, int>) {
       if (json_value.is_number_integer()) {
         member_ref = json_value.get<int>();
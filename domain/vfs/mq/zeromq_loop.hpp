@@ -1,6 +1,8 @@
 #ifndef OWL_VFS_MQ_ZEROMQ_LOOP
 #define OWL_VFS_MQ_ZEROMQ_LOOP
 
+#include <mutex>
+
 #include "vfs/core/socket/socket.hpp"
 
 namespace owl {
@@ -8,7 +10,7 @@ namespace owl {
 class ZeroMQLoop {
 public:
   using MessageHandler = std::function<void(
-      const std::string &, const std::string &, const nlohmann::json &)>;
+      const std::string &, const std::string &, nlohmann::json)>;
 
   explicit ZeroMQLoop(MessageHandler handler)
       : handler_(std::move(handler)),
@@ -43,15 +45,18 @@ public:
       return;
     }
 
-    if (auto msg = subscriber_.receiveString(zmq::recv_flags::dontwait)) {
+    // Parsed straight from the message buffer; the parsed message is then
+    // moved along to the controller.
+    if (auto msg = subscriber_.receive(zmq::recv_flags::dontwait)) {
       try {
-        auto json_msg = nlohmann::json::parse(*msg);
+        const auto *begin = static_cast<const char *>(msg->data());
+        auto json_msg = nlohmann::json::parse(begin, begin + msg->size());
 
         std::string verb = json_msg.value("type", "");
         std::string path = json_msg.value("path", "");
 
         if (handler_) {
-          handler_(verb, path, json_msg);
+          handler_(verb, path, std::move(json_msg));
         }
 
       } catch (const nlohmann::json::exception &e) {
@@ -72,6 +77,7 @@ public:
       response["error"] = data.value("error", "Unknown error");
     }
 
+    std::lock_guard lock(publisher_mutex_);
     publisher_.send(response.dump());
   }
 
@@ -82,6 +88,7 @@ private:
   MessageHandler handler_;
   Socket subscriber_;
   Socket publisher_;
+  std::mutex publisher_mutex_;
   std::atomic<bool> is_active_;
 };
 